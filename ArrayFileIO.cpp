@@ -0,0 +1,807 @@
+#include "ArrayFileIO.h"
+#include <fstream>
+#include <stdexcept>
+#include <cstring>
+#include <climits>
+#include <charconv>
+#include <chrono>
+#include <algorithm>
+#include <limits>
+#include "ThreadPool.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+  const char BINARY_MAGIC[4] = {'B', 'S', 'R', 'T'};
+  const uint8_t LITTLE_ENDIAN_MARK = 1;
+  const uint8_t BIG_ENDIAN_MARK = 2;
+
+  uint8_t hostEndianness()
+  {
+    const uint16_t probe = 1;
+    return *reinterpret_cast<const uint8_t *>(&probe) == 1 ? LITTLE_ENDIAN_MARK : BIG_ENDIAN_MARK;
+  }
+
+  bool isSpace(char c)
+  {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  // Розбір одного числа; токен містить лише непробільні символи
+  template <typename T>
+  bool parseToken(const char *first, const char *last, T &value)
+  {
+    if (first < last && *first == '+')
+    {
+      first++;
+    }
+    auto result = from_chars(first, last, value);
+    return result.ec == errc() && result.ptr == last;
+  }
+
+  // Кількість токенів у [p, end)
+  long long countTokens(const char *p, const char *end)
+  {
+    long long tokens = 0;
+    bool inToken = false;
+    for (; p < end; p++)
+    {
+      bool space = isSpace(*p);
+      tokens += !space && !inToken;
+      inToken = !space;
+    }
+    return tokens;
+  }
+
+  // Розбір токенів [p, end) у array[firstIndex...]; повертає глобальний індекс
+  // першого некоректного елемента або -1
+  template <typename T>
+  long long parseTokens(const char *p, const char *end, vector<T> &array, long long firstIndex)
+  {
+    long long index = firstIndex;
+    long long limit = array.size();
+
+    while (index < limit)
+    {
+      while (p < end && isSpace(*p))
+        p++;
+      if (p == end)
+        break;
+
+      const char *tokenStart = p;
+      while (p < end && !isSpace(*p))
+        p++;
+
+      if (!parseToken(tokenStart, p, array[index]))
+      {
+        return index;
+      }
+      index++;
+    }
+
+    return -1;
+  }
+
+  uint64_t rotl(uint64_t value, int bits)
+  {
+    return (value << bits) | (value >> (64 - bits));
+  }
+
+  // ArrayFileIO::checksum over data that arrives in pieces; the total size
+  // must be known in advance because it seeds the hash
+  class ChecksumState
+  {
+  public:
+    explicit ChecksumState(uint64_t totalBytes)
+        : hash(PRIME1 ^ totalBytes), pendingBytes(0), swapBytes(hostEndianness() != LITTLE_ENDIAN_MARK)
+    {
+    }
+
+    void update(const void *data, size_t bytes)
+    {
+      const unsigned char *p = static_cast<const unsigned char *>(data);
+
+      // Доповнюємо слово, розрізане попереднім фрагментом
+      if (pendingBytes > 0)
+      {
+        size_t take = min<size_t>(8 - pendingBytes, bytes);
+        memcpy(pending + pendingBytes, p, take);
+        pendingBytes += take;
+        p += take;
+        bytes -= take;
+        if (pendingBytes < 8)
+          return;
+        mixWord(pending);
+        pendingBytes = 0;
+      }
+
+      // Основна частина - по 8 байт, інтерпретованих як little-endian
+      size_t words = bytes / 8;
+      for (size_t i = 0; i < words; i++)
+      {
+        mixWord(p + i * 8);
+      }
+
+      pendingBytes = bytes - words * 8;
+      memcpy(pending, p + words * 8, pendingBytes);
+    }
+
+    uint64_t finish()
+    {
+      uint64_t result = hash;
+      for (size_t i = 0; i < pendingBytes; i++)
+      {
+        result = rotl(result ^ (pending[i] * PRIME2), 11) * PRIME1;
+      }
+
+      // Фінальне перемішування бітів
+      result ^= result >> 33;
+      result *= PRIME2;
+      result ^= result >> 29;
+      return result;
+    }
+
+  private:
+    static const uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+    static const uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+
+    uint64_t hash;
+    unsigned char pending[8];
+    size_t pendingBytes;
+    bool swapBytes;
+
+    void mixWord(const unsigned char *p)
+    {
+      uint64_t word;
+      memcpy(&word, p, 8);
+      if (swapBytes)
+        word = __builtin_bswap64(word);
+      hash = rotl(hash ^ (word * PRIME2), 31) * PRIME1;
+    }
+  };
+
+  // Відображення файлу в пам'ять тільки для читання; знімається в деструкторі
+  class MappedFile
+  {
+  public:
+    explicit MappedFile(const string &filename) : data(nullptr), size(0)
+    {
+      int fd = open(filename.c_str(), O_RDONLY);
+      if (fd < 0)
+      {
+        throw runtime_error("Неможливо відкрити файл для читання: " + filename);
+      }
+
+      struct stat info;
+      if (fstat(fd, &info) != 0)
+      {
+        close(fd);
+        throw runtime_error("Неможливо визначити розмір файлу: " + filename);
+      }
+      size = info.st_size;
+
+      if (size > 0)
+      {
+        void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED)
+        {
+          close(fd);
+          throw runtime_error("Помилка відображення файлу в пам'ять: " + filename);
+        }
+        data = static_cast<const char *>(mapped);
+        madvise(mapped, size, MADV_SEQUENTIAL);
+      }
+      close(fd);
+    }
+
+    ~MappedFile()
+    {
+      if (data)
+      {
+        munmap(const_cast<char *>(data), size);
+      }
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *data;
+    size_t size;
+  };
+
+  // Розбір першого рядка текстового файлу; повертає позицію після нього
+  const char *parseTextHeader(const char *p, const char *end, long long &size, const string &filename)
+  {
+    while (p < end && isSpace(*p))
+      p++;
+    const char *tokenStart = p;
+    while (p < end && !isSpace(*p))
+      p++;
+
+    if (!parseToken(tokenStart, p, size))
+    {
+      throw runtime_error("Помилка читання розміру масиву з файлу: " + filename);
+    }
+    if (size <= 0)
+    {
+      throw runtime_error("Некоректний розмір масиву в файлі: " + to_string(size));
+    }
+    return p;
+  }
+
+  // Найдовше текстове подання елемента разом з пробілом після нього
+  template <typename T>
+  size_t maxTextChars()
+  {
+    // Ціле: знак і всі цифри ("-2147483648"); дійсне: найкоротше точне подання з показником
+    return is_floating_point<T>::value ? numeric_limits<T>::max_digits10 + 8 : numeric_limits<T>::digits10 + 3;
+  }
+
+  // Перевірка бінарного заголовка для елементів заданого типу; числові поля переводяться
+  // в порядок байтів цієї машини, повертає true, якщо дані записані в іншому порядку
+  bool parseBinaryHeader(const MappedFile &file, BinaryArrayHeader &header, const string &filename,
+                         uint8_t elementWidth, ElementKind elementKind)
+  {
+    if (file.size < sizeof(BinaryArrayHeader))
+    {
+      throw runtime_error("Файл занадто малий для бінарного заголовка: " + filename);
+    }
+
+    memcpy(&header, file.data, sizeof(header));
+
+    if (memcmp(header.magic, BINARY_MAGIC, sizeof(header.magic)) != 0)
+    {
+      throw runtime_error("Файл не є бінарним файлом масиву: " + filename);
+    }
+    if (header.elementWidth != 4 && header.elementWidth != 8)
+    {
+      throw runtime_error("Непідтримуваний розмір елемента: " + to_string(header.elementWidth) + " байт");
+    }
+    ElementKind fileKind = static_cast<ElementKind>(header.elementKind);
+    if (header.elementWidth != elementWidth || fileKind != elementKind)
+    {
+      throw runtime_error(string("Тип елементів файлу (") + elementTypeName(fileKind, header.elementWidth) +
+                          ") не відповідає запитаному (" + elementTypeName(elementKind, elementWidth) + "): " + filename);
+    }
+    if (header.endianness != LITTLE_ENDIAN_MARK && header.endianness != BIG_ENDIAN_MARK)
+    {
+      throw runtime_error("Некоректний порядок байтів у заголовку файлу: " + filename);
+    }
+
+    // Числові поля заголовка записані в порядку байтів машини, що створила файл
+    bool foreignEndianness = header.endianness != hostEndianness();
+    if (foreignEndianness)
+    {
+      header.version = __builtin_bswap16(header.version);
+      header.count = __builtin_bswap64(header.count);
+      header.checksum = __builtin_bswap64(header.checksum);
+    }
+    if (header.version != ArrayFileIO::BINARY_VERSION)
+    {
+      throw runtime_error("Непідтримувана версія бінарного формату: " + to_string(header.version));
+    }
+    if (header.count == 0)
+    {
+      throw runtime_error("Некоректний розмір масиву в файлі: " + to_string(header.count));
+    }
+    size_t payloadBytes = file.size - sizeof(BinaryArrayHeader);
+    if (payloadBytes % elementWidth != 0 || payloadBytes / elementWidth != header.count)
+    {
+      throw runtime_error("Розмір файлу не відповідає кількості елементів у заголовку: " + filename);
+    }
+
+    return foreignEndianness;
+  }
+
+  uint32_t swapBytes(uint32_t value) { return __builtin_bswap32(value); }
+  uint64_t swapBytes(uint64_t value) { return __builtin_bswap64(value); }
+
+  // Зміна порядку байтів кожного елемента; біти дійсних чисел переставляються як ціле того ж розміру
+  template <typename T>
+  void swapElements(T *data, size_t n)
+  {
+    typedef typename conditional<sizeof(T) == 8, uint64_t, uint32_t>::type Bits;
+    static_assert(sizeof(T) == sizeof(Bits), "elements are 4 or 8 bytes");
+
+    for (size_t i = 0; i < n; i++)
+    {
+      Bits bits;
+      memcpy(&bits, &data[i], sizeof(bits));
+      bits = swapBytes(bits);
+      memcpy(&data[i], &bits, sizeof(bits));
+    }
+  }
+}
+
+uint64_t ArrayFileIO::checksum(const void *data, size_t bytes)
+{
+  ChecksumState state(bytes);
+  state.update(data, bytes);
+  return state.finish();
+}
+
+bool ArrayFileIO::isBinaryFile(const string &filename)
+{
+  ifstream file(filename, ios::binary);
+  if (!file.is_open())
+  {
+    throw runtime_error("Неможливо відкрити файл для читання: " + filename);
+  }
+
+  char magic[4];
+  return file.read(magic, sizeof(magic)) && memcmp(magic, BINARY_MAGIC, sizeof(magic)) == 0;
+}
+
+template <typename T>
+vector<T> ArrayFileIO::loadText(const string &filename, IoStats *stats)
+{
+  auto startTime = chrono::steady_clock::now();
+  MappedFile file(filename);
+  const char *end = file.data + file.size;
+
+  // Заголовок: кількість елементів
+  long long size;
+  const char *p = parseTextHeader(file.data, end, size, filename);
+  if (size > INT_MAX)
+  {
+    throw runtime_error("Некоректний розмір масиву в файлі: " + to_string(size));
+  }
+
+  vector<T> array(size);
+
+  // Межі частин зсуваються до найближчого пробілу, щоб не розрізати число
+  size_t bodyBytes = end - p;
+  ThreadPool &pool = ThreadPool::instance();
+  int numChunks = static_cast<int>(min<size_t>(max<size_t>(1, bodyBytes / MIN_PARSE_CHUNK_BYTES), pool.size()));
+  vector<const char *> bounds(numChunks + 1);
+  bounds[0] = p;
+  bounds[numChunks] = end;
+  for (int i = 1; i < numChunks; i++)
+  {
+    const char *b = p + bodyBytes * i / numChunks;
+    while (b < end && !isSpace(*b))
+      b++;
+    bounds[i] = max(b, bounds[i - 1]);
+  }
+
+  vector<long long> tokenCounts(numChunks, 0);
+  vector<long long> firstError(numChunks, -1);
+
+  // Прохід 1: кількість чисел у кожній частині, щоб знати, з якого індексу писати
+  if (numChunks > 1)
+  {
+    pool.runParallel(numChunks, [&](int chunk)
+                     { tokenCounts[chunk] = countTokens(bounds[chunk], bounds[chunk + 1]); });
+  }
+
+  // Прохід 2: розбір кожної частини прямо на її місце в масиві
+  vector<long long> offsets(numChunks, 0);
+  for (int i = 1; i < numChunks; i++)
+  {
+    offsets[i] = offsets[i - 1] + tokenCounts[i - 1];
+  }
+
+  pool.runParallel(numChunks, [&](int chunk)
+                   {
+                     if (offsets[chunk] < size)
+                     {
+                       firstError[chunk] = parseTokens(bounds[chunk], bounds[chunk + 1], array, offsets[chunk]);
+                     } });
+
+  // Помилка з найменшим індексом - та сама, яку знайшло б послідовне читання
+  for (int i = 0; i < numChunks; i++)
+  {
+    if (firstError[i] >= 0)
+    {
+      throw runtime_error("Помилка читання елементу #" + to_string(firstError[i]) + " з файлу: " + filename);
+    }
+  }
+
+  long long totalTokens = numChunks > 1 ? offsets[numChunks - 1] + tokenCounts[numChunks - 1]
+                                        : countTokens(bounds[0], bounds[1]);
+  if (totalTokens < size)
+  {
+    throw runtime_error("Помилка читання елементу #" + to_string(totalTokens) + " з файлу: " + filename);
+  }
+
+  if (stats)
+  {
+    stats->bytes = file.size;
+    stats->numThreads = numChunks;
+    stats->timeMs = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+  }
+
+  return array;
+}
+
+template <typename T>
+vector<T> ArrayFileIO::loadBinary(const string &filename, IoStats *stats)
+{
+  auto startTime = chrono::steady_clock::now();
+  MappedFile file(filename);
+
+  BinaryArrayHeader header;
+  bool foreignEndianness = parseBinaryHeader(file, header, filename, ElementTraits<T>::width, ElementTraits<T>::kind);
+  if (header.count > static_cast<uint64_t>(INT_MAX))
+  {
+    throw runtime_error("Некоректний розмір масиву в файлі: " + to_string(header.count));
+  }
+
+  size_t payloadBytes = header.count * sizeof(T);
+  const char *payload = file.data + sizeof(BinaryArrayHeader);
+  if (checksum(payload, payloadBytes) != header.checksum)
+  {
+    throw runtime_error("Контрольна сума не збігається, файл пошкоджено: " + filename);
+  }
+
+  // Дані копіюються з відображеної сторінки прямо у вектор, без розбору тексту
+  vector<T> array(header.count);
+  memcpy(array.data(), payload, payloadBytes);
+
+  if (foreignEndianness)
+  {
+    swapElements(array.data(), array.size());
+  }
+
+  if (stats)
+  {
+    stats->bytes = file.size;
+    stats->timeMs = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+  }
+
+  return array;
+}
+
+template <typename T>
+void ArrayFileIO::saveText(const vector<T> &array, const string &filename, IoStats *stats)
+{
+  auto startTime = chrono::steady_clock::now();
+
+  ofstream file(filename, ios::binary);
+  if (!file.is_open())
+  {
+    throw runtime_error("Неможливо відкрити файл для запису: " + filename);
+  }
+
+  string header = to_string(array.size()) + "\n";
+  file.write(header.data(), header.size());
+  size_t written = header.size();
+
+  const size_t MAX_CHARS_PER_VALUE = maxTextChars<T>();
+
+  ThreadPool &pool = ThreadPool::instance();
+  size_t numChunks = (array.size() + FORMAT_CHUNK_ELEMENTS - 1) / FORMAT_CHUNK_ELEMENTS;
+  int numThreads = static_cast<int>(max<size_t>(1, min<size_t>(numChunks, pool.size())));
+
+  // Буфер кожного потоку використовується повторно в усіх пакетах
+  vector<vector<char>> buffers(numThreads, vector<char>(FORMAT_CHUNK_ELEMENTS * MAX_CHARS_PER_VALUE));
+  vector<size_t> lengths(numThreads, 0);
+
+  // Пакет з numThreads частин форматується паралельно і записується по порядку
+  for (size_t batchStart = 0; batchStart < numChunks; batchStart += numThreads)
+  {
+    int batchSize = static_cast<int>(min<size_t>(numThreads, numChunks - batchStart));
+
+    auto formatChunk = [&](int slot)
+    {
+      size_t first = (batchStart + slot) * FORMAT_CHUNK_ELEMENTS;
+      size_t last = min(first + FORMAT_CHUNK_ELEMENTS, array.size());
+      char *out = buffers[slot].data();
+
+      for (size_t i = first; i < last; i++)
+      {
+        out = to_chars(out, out + MAX_CHARS_PER_VALUE, array[i]).ptr;
+        *out++ = ' ';
+      }
+      lengths[slot] = out - buffers[slot].data();
+    };
+
+    if (batchSize > 1)
+    {
+      pool.runParallel(batchSize, formatChunk);
+    }
+    else
+    {
+      formatChunk(0);
+    }
+
+    for (int slot = 0; slot < batchSize; slot++)
+    {
+      file.write(buffers[slot].data(), lengths[slot]);
+      written += lengths[slot];
+    }
+  }
+
+  file.close();
+  if (!file)
+  {
+    throw runtime_error("Помилка запису у файл: " + filename);
+  }
+
+  if (stats)
+  {
+    stats->bytes = written;
+    stats->numThreads = numThreads;
+    stats->timeMs = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+  }
+}
+
+template <typename T>
+void ArrayFileIO::saveBinary(const vector<T> &array, const string &filename, IoStats *stats)
+{
+  auto startTime = chrono::steady_clock::now();
+
+  ofstream file(filename, ios::binary);
+  if (!file.is_open())
+  {
+    throw runtime_error("Неможливо відкрити файл для запису: " + filename);
+  }
+
+  BinaryArrayHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, BINARY_MAGIC, sizeof(header.magic));
+  header.version = BINARY_VERSION;
+  header.elementWidth = ElementTraits<T>::width;
+  header.elementKind = static_cast<uint8_t>(ElementTraits<T>::kind);
+  header.endianness = hostEndianness();
+  header.count = array.size();
+  header.checksum = checksum(array.data(), array.size() * sizeof(T));
+
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(array.data()), array.size() * sizeof(T));
+
+  file.close();
+  if (!file)
+  {
+    throw runtime_error("Помилка запису у файл: " + filename);
+  }
+
+  if (stats)
+  {
+    stats->bytes = sizeof(header) + array.size() * sizeof(T);
+    stats->timeMs = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+  }
+}
+
+// Типи елементів, для яких компілюються завантаження і збереження
+#define ARRAY_FILE_IO_INSTANTIATE(T)                                                   \
+  template vector<T> ArrayFileIO::loadText<T>(const string &, IoStats *);              \
+  template vector<T> ArrayFileIO::loadBinary<T>(const string &, IoStats *);            \
+  template void ArrayFileIO::saveText<T>(const vector<T> &, const string &, IoStats *); \
+  template void ArrayFileIO::saveBinary<T>(const vector<T> &, const string &, IoStats *);
+
+ARRAY_FILE_IO_INSTANTIATE(int32_t)
+ARRAY_FILE_IO_INSTANTIATE(int64_t)
+ARRAY_FILE_IO_INSTANTIATE(float)
+ARRAY_FILE_IO_INSTANTIATE(double)
+
+#undef ARRAY_FILE_IO_INSTANTIATE
+
+template <typename T>
+struct ArrayFileReader<T>::Mapping
+{
+  MappedFile file;
+  ChecksumState checksum;
+  uint64_t expectedChecksum;
+  size_t releasedBytes; // Початок ще не звільнених сторінок
+
+  explicit Mapping(const string &filename) : file(filename), checksum(0), expectedChecksum(0), releasedBytes(0) {}
+};
+
+template <typename T>
+ArrayFileReader<T>::ArrayFileReader(const string &filename)
+    : mapping(new Mapping(filename)), filename(filename), format(ArrayFileFormat::Text), count(0), position(0),
+      cursor(nullptr), foreignEndianness(false)
+{
+  const MappedFile &file = mapping->file;
+
+  if (file.size >= sizeof(BINARY_MAGIC) && memcmp(file.data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0)
+  {
+    BinaryArrayHeader header;
+    foreignEndianness = parseBinaryHeader(file, header, filename, ElementTraits<T>::width, ElementTraits<T>::kind);
+    format = ArrayFileFormat::Binary;
+    count = header.count;
+    cursor = file.data + sizeof(BinaryArrayHeader);
+    mapping->checksum = ChecksumState(header.count * sizeof(T));
+    mapping->expectedChecksum = header.checksum;
+  }
+  else
+  {
+    long long size;
+    cursor = parseTextHeader(file.data, file.data + file.size, size, filename);
+    count = size;
+  }
+}
+
+template <typename T>
+ArrayFileReader<T>::~ArrayFileReader() {}
+
+template <typename T>
+size_t ArrayFileReader<T>::bytesRead() const
+{
+  return cursor - mapping->file.data;
+}
+
+template <typename T>
+size_t ArrayFileReader<T>::read(vector<T> &chunk, size_t maxElements)
+{
+  const MappedFile &file = mapping->file;
+  const char *end = file.data + file.size;
+  size_t n = min(maxElements, count - position);
+  chunk.resize(n);
+
+  if (format == ArrayFileFormat::Binary)
+  {
+    memcpy(chunk.data(), cursor, n * sizeof(T));
+    mapping->checksum.update(cursor, n * sizeof(T));
+    cursor += n * sizeof(T);
+
+    if (foreignEndianness)
+    {
+      swapElements(chunk.data(), n);
+    }
+
+    if (position + n == count && n > 0 && mapping->checksum.finish() != mapping->expectedChecksum)
+    {
+      throw runtime_error("Контрольна сума не збігається, файл пошкоджено: " + filename);
+    }
+  }
+  else
+  {
+    const char *p = cursor;
+    for (size_t i = 0; i < n; i++)
+    {
+      while (p < end && isSpace(*p))
+        p++;
+      const char *tokenStart = p;
+      while (p < end && !isSpace(*p))
+        p++;
+
+      if (!parseToken(tokenStart, p, chunk[i]))
+      {
+        throw runtime_error("Помилка читання елементу #" + to_string(position + i) + " з файлу: " + filename);
+      }
+    }
+    cursor = p;
+  }
+  position += n;
+
+  // Прочитані сторінки більше не потрібні: не тримаємо у пам'яті процесу весь файл
+  const size_t PAGE = 4096;
+  size_t consumed = (cursor - file.data) / PAGE * PAGE;
+  if (consumed > mapping->releasedBytes)
+  {
+    madvise(const_cast<char *>(file.data) + mapping->releasedBytes, consumed - mapping->releasedBytes, MADV_DONTNEED);
+    mapping->releasedBytes = consumed;
+  }
+
+  return n;
+}
+
+template <typename T>
+struct ArrayFileWriter<T>::Stream
+{
+  ofstream file;
+  ChecksumState checksum;
+  vector<char> buffer;
+  size_t used;
+
+  Stream(const string &filename, size_t payloadBytes) : file(filename, ios::binary), checksum(payloadBytes), used(0) {}
+};
+
+template <typename T>
+ArrayFileWriter<T>::ArrayFileWriter(const string &filename, ArrayFileFormat format, size_t count)
+    : stream(new Stream(filename, count * sizeof(T))), filename(filename), format(format), count(count), written(0), bytes(0)
+{
+  if (!stream->file.is_open())
+  {
+    throw runtime_error("Неможливо відкрити файл для запису: " + filename);
+  }
+
+  if (format == ArrayFileFormat::Binary)
+  {
+    // Контрольна сума ще невідома, заголовок перезаписується у finish()
+    BinaryArrayHeader header;
+    memset(&header, 0, sizeof(header));
+    stream->file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    bytes = sizeof(header);
+  }
+  else
+  {
+    string header = to_string(count) + "\n";
+    stream->file.write(header.data(), header.size());
+    bytes = header.size();
+    stream->buffer.resize(WRITE_BUFFER_BYTES);
+  }
+}
+
+template <typename T>
+ArrayFileWriter<T>::~ArrayFileWriter() {}
+
+template <typename T>
+void ArrayFileWriter<T>::write(const T *data, size_t n)
+{
+  if (written + n > count)
+  {
+    throw runtime_error("Спроба записати більше елементів, ніж зазначено в заголовку: " + filename);
+  }
+  written += n;
+
+  if (format == ArrayFileFormat::Binary)
+  {
+    stream->checksum.update(data, n * sizeof(T));
+    stream->file.write(reinterpret_cast<const char *>(data), n * sizeof(T));
+    bytes += n * sizeof(T);
+    return;
+  }
+
+  const size_t MAX_CHARS_PER_VALUE = maxTextChars<T>();
+  vector<char> &buffer = stream->buffer;
+
+  for (size_t i = 0; i < n; i++)
+  {
+    if (buffer.size() - stream->used < MAX_CHARS_PER_VALUE)
+    {
+      stream->file.write(buffer.data(), stream->used);
+      bytes += stream->used;
+      stream->used = 0;
+    }
+
+    char *out = buffer.data() + stream->used;
+    out = to_chars(out, out + MAX_CHARS_PER_VALUE, data[i]).ptr;
+    *out++ = ' ';
+    stream->used = out - buffer.data();
+  }
+}
+
+template <typename T>
+void ArrayFileWriter<T>::finish()
+{
+  if (written != count)
+  {
+    throw runtime_error("Записано " + to_string(written) + " елементів замість " + to_string(count) + ": " + filename);
+  }
+
+  ofstream &file = stream->file;
+
+  if (format == ArrayFileFormat::Binary)
+  {
+    BinaryArrayHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BINARY_MAGIC, sizeof(header.magic));
+    header.version = ArrayFileIO::BINARY_VERSION;
+    header.elementWidth = ElementTraits<T>::width;
+    header.elementKind = static_cast<uint8_t>(ElementTraits<T>::kind);
+    header.endianness = hostEndianness();
+    header.count = count;
+    header.checksum = stream->checksum.finish();
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  }
+  else
+  {
+    file.write(stream->buffer.data(), stream->used);
+    bytes += stream->used;
+    stream->used = 0;
+  }
+
+  file.close();
+  if (!file)
+  {
+    throw runtime_error("Помилка запису у файл: " + filename);
+  }
+}
+
+// Потокове читання і запис для тих самих типів елементів
+template class ArrayFileReader<int32_t>;
+template class ArrayFileReader<int64_t>;
+template class ArrayFileReader<float>;
+template class ArrayFileReader<double>;
+template class ArrayFileWriter<int32_t>;
+template class ArrayFileWriter<int64_t>;
+template class ArrayFileWriter<float>;
+template class ArrayFileWriter<double>;
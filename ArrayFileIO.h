@@ -0,0 +1,157 @@
+#ifndef ARRAY_FILE_IO_H
+#define ARRAY_FILE_IO_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include "ElementOrder.h"
+
+using namespace std;
+
+// On-disk formats of array files
+enum class ArrayFileFormat
+{
+  Text,  // "<size>\n<v0> <v1> ... "
+  Binary // 32-byte header + raw little/big-endian elements
+};
+
+// Header of the binary array format (version 1), 32 bytes.
+// The payload of `count` elements of `elementWidth` bytes follows directly.
+struct BinaryArrayHeader
+{
+  char magic[4];        // "BSRT"
+  uint16_t version;     // Версія формату
+  uint8_t elementWidth; // Розмір елемента в байтах (4 для int)
+  uint8_t endianness;   // 1 - little-endian, 2 - big-endian
+  uint64_t count;       // Кількість елементів
+  uint64_t checksum;    // Контрольна сума даних (ArrayFileIO::checksum)
+  uint8_t elementKind;  // ElementKind; 0 (ціле зі знаком) у файлах, створених до появи цього поля
+  uint8_t reserved[7];
+};
+
+// Size and duration of one file operation
+struct IoStats
+{
+  size_t bytes;
+  double timeMs;
+  int numThreads;
+
+  IoStats() : bytes(0), timeMs(0), numThreads(1) {}
+
+  // Throughput in GB/s (10^9 bytes per second)
+  double throughputGBs() const { return timeMs > 0 ? bytes / (timeMs * 1e6) : 0; }
+};
+
+// Reading and writing array files in the supported formats. The element
+// type is a template parameter; int32_t, int64_t, float and double are
+// instantiated in ArrayFileIO.cpp. Binary files record the element type and
+// are only loaded as that type; text files are parsed as the requested type.
+class ArrayFileIO
+{
+public:
+  static const uint16_t BINARY_VERSION = 1;
+
+  // Check the magic bytes at the start of a file
+  static bool isBinaryFile(const string &filename);
+
+  // Load a text array file: the mapped file is split at whitespace and parsed
+  // with from_chars on several threads directly into the result array
+  template <typename T = int>
+  static vector<T> loadText(const string &filename, IoStats *stats = nullptr);
+
+  // Load a binary array file through mmap (no parsing step)
+  template <typename T = int>
+  static vector<T> loadBinary(const string &filename, IoStats *stats = nullptr);
+
+  // Save an array in the text format: chunks are formatted with to_chars into
+  // per-thread buffers in parallel and written in order with large writes
+  template <typename T>
+  static void saveText(const vector<T> &array, const string &filename, IoStats *stats = nullptr);
+
+  // Save an array in the binary format
+  template <typename T>
+  static void saveBinary(const vector<T> &array, const string &filename, IoStats *stats = nullptr);
+
+  // 64-bit checksum of a byte range (independent of host endianness)
+  static uint64_t checksum(const void *data, size_t bytes);
+
+  // Minimum amount of text per parser thread
+  static const size_t MIN_PARSE_CHUNK_BYTES = 1 << 20;
+
+  // Elements formatted by one thread before its buffer is written out
+  static const size_t FORMAT_CHUNK_ELEMENTS = 1 << 18;
+};
+
+// Sequential chunk-by-chunk reader of an array file in either format, for
+// files that do not fit in memory. Pages already consumed are released.
+// Instantiated for the same element types as ArrayFileIO; a binary file must
+// hold elements of type T.
+template <typename T = int>
+class ArrayFileReader
+{
+public:
+  explicit ArrayFileReader(const string &filename);
+  ~ArrayFileReader();
+
+  ArrayFileReader(const ArrayFileReader &) = delete;
+  ArrayFileReader &operator=(const ArrayFileReader &) = delete;
+
+  ArrayFileFormat getFormat() const { return format; }
+
+  // Number of elements declared in the file header
+  size_t size() const { return count; }
+
+  // Read up to maxElements next elements into chunk (resized to the number
+  // read; 0 at the end). The binary checksum is verified with the last chunk.
+  size_t read(vector<T> &chunk, size_t maxElements);
+
+  size_t bytesRead() const;
+
+private:
+  struct Mapping;
+  unique_ptr<Mapping> mapping;
+  string filename;
+  ArrayFileFormat format;
+  size_t count;
+  size_t position; // Кількість уже прочитаних елементів
+  const char *cursor;
+  bool foreignEndianness;
+};
+
+// Sequential writer of an array file whose size is known in advance.
+// Values are buffered and written with large writes; in the binary format the
+// checksum is computed on the fly and the header is completed by finish().
+template <typename T = int>
+class ArrayFileWriter
+{
+public:
+  ArrayFileWriter(const string &filename, ArrayFileFormat format, size_t count);
+  ~ArrayFileWriter();
+
+  ArrayFileWriter(const ArrayFileWriter &) = delete;
+  ArrayFileWriter &operator=(const ArrayFileWriter &) = delete;
+
+  void write(const T *data, size_t n);
+
+  // Flush the buffer and complete the file; throws if fewer than count
+  // elements were written
+  void finish();
+
+  size_t bytesWritten() const { return bytes; }
+
+  // Size of the text formatting buffer
+  static const size_t WRITE_BUFFER_BYTES = 1 << 20;
+
+private:
+  struct Stream;
+  unique_ptr<Stream> stream;
+  string filename;
+  ArrayFileFormat format;
+  size_t count;
+  size_t written; // Кількість уже записаних елементів
+  size_t bytes;
+};
+
+#endif // ARRAY_FILE_IO_H
@@ -0,0 +1,256 @@
+#include "ArrayGenerator.h"
+#include "Philox.h"
+#include "ThreadPool.h"
+#include "SimdSort.h"
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+
+namespace
+{
+  // Окремий потік Philox для вибору пар обміну, незалежний від значень елементів
+  const uint64_t SWAP_STREAM = 0x5851F42D4C957F2DULL;
+
+  // Рівномірне число в [0, range) з 64 випадкових біт: множення з відкиданням
+  // молодших 64 біт, зміщення розподілу не більше range / 2^64
+  uint64_t scaleBits(uint64_t bits, uint64_t range)
+  {
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(bits) * range) >> 64);
+  }
+
+  // Паралельне заповнення: array[i] = valueAt(i)
+  template <typename ValueAt>
+  void fillIndexed(vector<int> &array, int numChunks, const ValueAt &valueAt)
+  {
+    int size = array.size();
+    auto fillChunk = [&](int chunk)
+    {
+      int first = static_cast<int>(static_cast<long long>(size) * chunk / numChunks);
+      int last = static_cast<int>(static_cast<long long>(size) * (chunk + 1) / numChunks);
+      for (int i = first; i < last; i++)
+      {
+        array[i] = valueAt(i);
+      }
+    };
+
+    if (numChunks > 1)
+    {
+      ThreadPool::instance().runParallel(numChunks, fillChunk);
+    }
+    else
+    {
+      fillChunk(0);
+    }
+  }
+
+  // Паралельне заповнення: array[i] = valueOf(64 біти елемента i).
+  // Елемент i отримує половину блоку Philox з номером i / 2, тому результат
+  // не залежить від того, як масив поділено між потоками
+  template <typename ValueOf>
+  void fillFromBits(vector<int> &array, uint64_t seed, int numChunks, const ValueOf &valueOf)
+  {
+    int size = array.size();
+    auto fillChunk = [&](int chunk)
+    {
+      int first = static_cast<int>(static_cast<long long>(size) * chunk / numChunks);
+      int last = static_cast<int>(static_cast<long long>(size) * (chunk + 1) / numChunks);
+
+      PhiloxBlock block = Philox::generate(first / 2, seed);
+      for (int i = first; i < last; i++)
+      {
+        if (i % 2 == 0 && i != first)
+        {
+          block = Philox::generate(i / 2, seed);
+        }
+
+        int half = (i % 2) * 2;
+        array[i] = valueOf((static_cast<uint64_t>(block.words[half + 1]) << 32) | block.words[half]);
+      }
+    };
+
+    if (numChunks > 1)
+    {
+      ThreadPool::instance().runParallel(numChunks, fillChunk);
+    }
+    else
+    {
+      fillChunk(0);
+    }
+  }
+}
+
+uint64_t ArrayGenerator::randomSeed()
+{
+  random_device rd;
+  return (static_cast<uint64_t>(rd()) << 32) | rd();
+}
+
+int ArrayGenerator::generateChunks(int size, int numThreads)
+{
+  int maxChunks = numThreads > 0 ? numThreads : ThreadPool::instance().size();
+  return max(1, min(maxChunks, size / MIN_GENERATE_CHUNK));
+}
+
+vector<int> ArrayGenerator::uniform(int size, int minValue, int maxValue, uint64_t seed, int numThreads)
+{
+  vector<int> array(size);
+  uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(maxValue) - minValue) + 1;
+
+  fillFromBits(array, seed, generateChunks(size, numThreads), [=](uint64_t bits)
+               { return static_cast<int>(minValue + static_cast<int64_t>(scaleBits(bits, range))); });
+
+  return array;
+}
+
+vector<int> ArrayGenerator::generate(int size, Distribution distribution, const DistributionParams &params, uint64_t seed, int numThreads)
+{
+  if (size < 0)
+  {
+    throw runtime_error("Розмір масиву не може бути від'ємним");
+  }
+  if (params.minValue > params.maxValue)
+  {
+    throw runtime_error("Мінімальне значення не може бути більшим за максимальне");
+  }
+
+  int minValue = params.minValue;
+  uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(params.maxValue) - minValue) + 1;
+  int numChunks = generateChunks(size, numThreads);
+
+  switch (distribution)
+  {
+  case Distribution::Uniform:
+    return uniform(size, params.minValue, params.maxValue, seed, numThreads);
+
+  case Distribution::Sorted:
+  case Distribution::Reversed:
+  case Distribution::NearlySorted:
+  {
+    // Ті самі значення, що й у рівномірного масиву з цим seed, але впорядковані
+    vector<int> array = uniform(size, params.minValue, params.maxValue, seed, numThreads);
+    SimdSort::sort(array.data(), size);
+
+    if (distribution == Distribution::Reversed)
+    {
+      reverse(array.begin(), array.end());
+    }
+    else if (distribution == Distribution::NearlySorted && size > 1)
+    {
+      for (int s = 0; s < params.swaps; s++)
+      {
+        PhiloxBlock block = Philox::generate(s, seed ^ SWAP_STREAM);
+        uint64_t first = scaleBits((static_cast<uint64_t>(block.words[1]) << 32) | block.words[0], size);
+        uint64_t second = scaleBits((static_cast<uint64_t>(block.words[3]) << 32) | block.words[2], size);
+        swap(array[first], array[second]);
+      }
+    }
+    return array;
+  }
+
+  case Distribution::Sawtooth:
+  {
+    vector<int> array(size);
+    uint64_t period = max(1, params.period);
+    fillIndexed(array, numChunks, [=](int i)
+                { return static_cast<int>(minValue + static_cast<int64_t>(i % period * range / period)); });
+    return array;
+  }
+
+  case Distribution::OrganPipe:
+  {
+    vector<int> array(size);
+    uint64_t half = (static_cast<uint64_t>(size) + 1) / 2;
+    fillIndexed(array, numChunks, [=](int i)
+                {
+                  uint64_t step = static_cast<uint64_t>(i) < half ? i : size - 1 - i;
+                  return static_cast<int>(minValue + static_cast<int64_t>(step * range / half)); });
+    return array;
+  }
+
+  case Distribution::FewUnique:
+  {
+    vector<int> array(size);
+    uint64_t unique = min<uint64_t>(max(1, params.uniqueValues), range);
+    uint64_t spacing = unique > 1 ? (range - 1) / (unique - 1) : 0;
+    fillFromBits(array, seed, numChunks, [=](uint64_t bits)
+                 { return static_cast<int>(minValue + static_cast<int64_t>(scaleBits(bits, unique) * spacing)); });
+    return array;
+  }
+
+  case Distribution::Zipf:
+  {
+    if (!(params.zipfExponent > 0))
+    {
+      throw runtime_error("Показник розподілу Ципфа має бути додатним");
+    }
+
+    // Нормована функція розподілу рангів; ранг шукається бінарним пошуком
+    int ranks = static_cast<int>(min<uint64_t>(range, MAX_ZIPF_RANKS));
+    vector<double> cdf(ranks);
+    double total = 0;
+    for (int r = 0; r < ranks; r++)
+    {
+      total += 1.0 / pow(r + 1.0, params.zipfExponent);
+      cdf[r] = total;
+    }
+    for (double &value : cdf)
+    {
+      value /= total;
+    }
+
+    vector<int> array(size);
+    const vector<double> &table = cdf;
+    fillFromBits(array, seed, numChunks, [&](uint64_t bits)
+                 {
+                   double u = (bits >> 11) * (1.0 / 9007199254740992.0); // [0, 1) з 53 біт
+                   int rank = upper_bound(table.begin(), table.end(), u) - table.begin();
+                   return minValue + min(rank, ranks - 1); });
+    return array;
+  }
+
+  case Distribution::AllEqual:
+    return vector<int>(size, minValue);
+  }
+
+  throw runtime_error("Невідомий розподіл");
+}
+
+string ArrayGenerator::distributionName(Distribution distribution)
+{
+  switch (distribution)
+  {
+  case Distribution::Uniform:
+    return "uniform";
+  case Distribution::Sorted:
+    return "sorted";
+  case Distribution::Reversed:
+    return "reversed";
+  case Distribution::NearlySorted:
+    return "nearly-sorted";
+  case Distribution::Sawtooth:
+    return "sawtooth";
+  case Distribution::OrganPipe:
+    return "organ-pipe";
+  case Distribution::FewUnique:
+    return "few-unique";
+  case Distribution::Zipf:
+    return "zipf";
+  case Distribution::AllEqual:
+    return "all-equal";
+  }
+  return "unknown";
+}
+
+Distribution ArrayGenerator::distributionFromName(const string &name)
+{
+  for (int i = 0; i < NUM_DISTRIBUTIONS; i++)
+  {
+    Distribution distribution = static_cast<Distribution>(i);
+    if (distributionName(distribution) == name)
+    {
+      return distribution;
+    }
+  }
+  throw runtime_error("Невідомий розподіл: " + name);
+}
@@ -0,0 +1,70 @@
+#ifndef ARRAY_GENERATOR_H
+#define ARRAY_GENERATOR_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+// Input shapes for benchmarking the sort engines on best and worst cases
+enum class Distribution
+{
+  Uniform,      // Independent uniform values in [min, max]
+  Sorted,       // Uniform values in ascending order
+  Reversed,     // Uniform values in descending order
+  NearlySorted, // Sorted, then `swaps` random pairs exchanged
+  Sawtooth,     // Repeated ascending ramps of `period` elements
+  OrganPipe,    // Ascending first half, descending second half
+  FewUnique,    // `uniqueValues` evenly spaced values in random order
+  Zipf,         // min + rank - 1, rank drawn with P(rank) ~ 1 / rank^s
+  AllEqual      // Every element equals min
+};
+
+// Parameters of a generated array; each distribution uses only the ones it needs
+struct DistributionParams
+{
+  int minValue;
+  int maxValue;
+  int swaps;           // NearlySorted
+  int period;          // Sawtooth
+  int uniqueValues;    // FewUnique
+  double zipfExponent; // Zipf, s > 0
+
+  DistributionParams() : minValue(0), maxValue(100), swaps(10), period(1000), uniqueValues(10), zipfExponent(1.0) {}
+};
+
+// Deterministic array generators. Every random choice is drawn from the
+// Philox counter-based generator, so the output depends only on the seed and
+// the parameters, and is the same for any number of threads.
+class ArrayGenerator
+{
+public:
+  static const int NUM_DISTRIBUTIONS = 9;
+
+  // Uniform values in [minValue, maxValue], filled in parallel. numThreads
+  // limits the threads used (0 - every pool worker); it never changes the result.
+  static vector<int> uniform(int size, int minValue, int maxValue, uint64_t seed, int numThreads = 0);
+
+  static vector<int> generate(int size, Distribution distribution, const DistributionParams &params, uint64_t seed, int numThreads = 0);
+
+  // Fresh seed from random_device
+  static uint64_t randomSeed();
+
+  static string distributionName(Distribution distribution);
+
+  // Inverse of distributionName; throws runtime_error for unknown names
+  static Distribution distributionFromName(const string &name);
+
+  // Minimum number of elements generated by one thread
+  static const int MIN_GENERATE_CHUNK = 1 << 16;
+
+private:
+  // Largest number of Zipf ranks (size of the cumulative distribution table)
+  static const int MAX_ZIPF_RANKS = 1 << 20;
+
+  // Number of parallel chunks for an array of the given size
+  static int generateChunks(int size, int numThreads);
+};
+
+#endif // ARRAY_GENERATOR_H
@@ -1,5 +1,4 @@
-#include "ArrayOperations.h"
-#include <random>
+#include "ArrayOperationsImpl.h"
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
@@ -11,12 +10,20 @@
 #include <chrono>
 #include <ctime>
 #include <sstream>
+#include <atomic>
+#include "ThreadPool.h"
+#include "WorkStealingScheduler.h"
 
 // Мютекс для уникнення перемішування виводу з різних потоків
 mutex consoleMutex;
 
 // Отримати поточну часову мітку для виведення
 string ArrayOperations::getCurrentTimestamp()
+{
+  return currentTimestamp();
+}
+
+string currentTimestamp()
 {
   auto now = chrono::system_clock::now();
   auto now_c = chrono::system_clock::to_time_t(now);
@@ -27,535 +34,477 @@ string ArrayOperations::getCurrentTimestamp()
   return ss.str();
 }
 
-vector<int> ArrayOperations::generateRandomArray(int size, int minValue, int maxValue)
+uint64_t ArrayOperations::randomSeed()
 {
-  vector<int> array(size);
-  random_device rd;
-  mt19937 gen(rd());
-  uniform_int_distribution<> distrib(minValue, maxValue);
+  return ArrayGenerator::randomSeed();
+}
 
-  for (int i = 0; i < size; i++)
-  {
-    array[i] = distrib(gen);
-  }
+vector<int> ArrayOperations::generateRandomArray(int size, int minValue, int maxValue)
+{
+  return generateRandomArray(size, minValue, maxValue, randomSeed());
+}
 
-  return array;
+vector<int> ArrayOperations::generateRandomArray(int size, int minValue, int maxValue, uint64_t seed)
+{
+  return ArrayGenerator::uniform(size, minValue, maxValue, seed);
 }
 
-void ArrayOperations::saveArrayToFile(const vector<int> &array, const string &filename)
+vector<int> ArrayOperations::generateArray(int size, Distribution distribution, const DistributionParams &params, uint64_t seed, int numThreads)
 {
-  ofstream file(filename);
-  if (!file.is_open())
-  {
-    throw runtime_error("Неможливо відкрити файл для запису: " + filename);
-  }
+  return ArrayGenerator::generate(size, distribution, params, seed, numThreads);
+}
 
-  file << array.size() << endl;
-  for (int value : array)
-  {
-    file << value << " ";
-  }
+// Record how much work the shared pool did during one sort
+void ArrayOperations::recordPoolStats(SortMetrics &metrics, const ThreadPoolStats &before)
+{
+  ThreadPoolStats after = ThreadPool::instance().getStats();
 
-  file.close();
-  cout << "Файл " << filename << " успішно збережено. Розмір: " << array.size() << " елементів." << endl;
+  stringstream ss;
+  ss << fixed << setprecision(3) << (after.idleTimeMs - before.idleTimeMs);
+  metrics.additionalInfo["poolTasks"] = to_string(after.tasksCompleted - before.tasksCompleted);
+  metrics.additionalInfo["poolIdleMs"] = ss.str();
 }
 
-vector<int> ArrayOperations::loadArrayFromFile(const string &filename)
+// Phases of a scheduler-based sort and the derived parallelism metrics
+void ArrayOperations::recordParallelProfile(SortMetrics &metrics, double setupMs, double sortMs, double finalizeMs,
+                                            const WorkStealingStats &schedulerStats,
+                                            const vector<double> &threadSortMs, const vector<double> &threadMergeMs)
 {
-  ifstream file(filename);
-  if (!file.is_open())
-  {
-    throw runtime_error("Неможливо відкрити файл для читання: " + filename);
-  }
-
-  int size;
-  if (!(file >> size))
-  {
-    throw runtime_error("Помилка читання розміру масиву з файлу: " + filename);
+  ParallelProfile &profile = metrics.parallel;
+  profile.recorded = true;
+
+  // Межі фаз від початку run(): старт останнього робітника, завершення останнього робітника
+  double lastStartMs = 0;
+  double lastEndMs = 0;
+  for (size_t w = 0; w < schedulerStats.workerStartMs.size(); w++)
+  {
+    lastStartMs = max(lastStartMs, schedulerStats.workerStartMs[w]);
+    lastEndMs = max(lastEndMs, schedulerStats.workerEndMs[w]);
+  }
+
+  profile.setupMs = setupMs;
+  profile.spawnMs = lastStartMs;
+  profile.sortMs = sortMs;
+  profile.mergeMs = max(0.0, lastEndMs - sortMs);
+  profile.joinMs = max(0.0, schedulerStats.runMs - lastEndMs);
+  profile.finalizeMs = finalizeMs;
+  profile.threadSortMs = threadSortMs;
+  profile.threadMergeMs = threadMergeMs;
+  profile.threadTaskCpuMs = schedulerStats.workerTaskCpuMs;
+  profile.threadCpuMs = schedulerStats.workerCpuMs;
+
+  // Робота потоку - процесорний час його задач: на перевантаженій машині потік задачі може чекати на ядро,
+  // тому настінний час задач завищив би роботу
+  int numThreads = schedulerStats.workerTaskCpuMs.size();
+  double totalWork = 0;
+  double maxWork = 0;
+  for (int w = 0; w < numThreads; w++)
+  {
+    double work = schedulerStats.workerTaskCpuMs[w];
+    totalWork += work;
+    maxWork = max(maxWork, work);
+  }
+
+  double meanWork = numThreads > 0 ? totalWork / numThreads : 0;
+  profile.loadImbalance = meanWork > 0 ? maxWork / meanWork : 1.0;
+
+  // Послідовний час оцінюється сумарною роботою потоків, тоді прискорення S = робота / загальний час,
+  // а частка послідовної роботи за Карпом-Флаттом e = (1/S - 1/p) / (1 - 1/p)
+  double wallMs = metrics.executionTimeMs;
+  if (wallMs > 0 && numThreads > 0)
+  {
+    double speedup = totalWork / wallMs;
+    profile.parallelEfficiency = speedup / numThreads;
+    if (numThreads > 1 && speedup > 0)
+    {
+      profile.serialFraction = (1.0 / speedup - 1.0 / numThreads) / (1.0 - 1.0 / numThreads);
+    }
   }
+}
 
-  if (size <= 0)
+int ArrayOperations::resolveThreadCount(int numThreads, int n, bool verbose)
+{
+  // Determine number of threads if not specified
+  if (numThreads <= 0)
   {
-    throw runtime_error("Некоректний розмір масиву в файлі: " + to_string(size));
+    numThreads = thread::hardware_concurrency();
+    if (numThreads == 0)
+      numThreads = 4; // Default to 4 if hardware_concurrency returns 0
   }
 
-  vector<int> array(size);
-  for (int i = 0; i < size; i++)
+  // Limit number of threads based on array size
+  int maxThreads = max(1, n / 1000);
+  if (numThreads > maxThreads)
   {
-    if (!(file >> array[i]))
+    if (verbose)
+    {
+      cout << getCurrentTimestamp() << " | Увага: кількість потоків зменшено з " << numThreads
+           << " до " << maxThreads << " через малий розмір масиву (" << n << " елементів)." << endl;
+    }
+    else
     {
-      throw runtime_error("Помилка читання елементу #" + to_string(i) + " з файлу: " + filename);
+      cout << "Увага: кількість потоків зменшено з " << numThreads << " до " << maxThreads
+           << " через малий розмір масиву (" << n << " елементів)." << endl;
     }
+    numThreads = maxThreads;
   }
 
-  file.close();
-  return array;
+  return numThreads;
 }
 
-// Helper function for bubble sort in a specific range
-void ArrayOperations::bubbleSortRange(vector<int> &array, int start, int end, long long &comparisons, long long &swaps, bool verbose, int threadId)
+int ArrayOperations::scanThreadCount(size_t size, int numThreads)
 {
-  string threadInfo = threadId >= 0 ? "Потік " + to_string(threadId) : "Основний потік";
-
-  if (verbose)
+  if (numThreads <= 0)
   {
-    lock_guard<mutex> lock(consoleMutex);
-    cout << getCurrentTimestamp() << " | " << threadInfo << " | Початок сортування діапазону ["
-         << start << " - " << end << ") розміром " << (end - start) << " елементів" << endl;
+    numThreads = ThreadPool::instance().size();
   }
 
-  for (int i = start; i < end - 1; i++)
-  {
-    for (int j = start; j < end - (i - start) - 1; j++)
-    {
-      comparisons++;
-
-      if (verbose && comparisons % 1000 == 0)
-      { // Обмежуємо кількість виведень для продуктивності
-        lock_guard<mutex> lock(consoleMutex);
-        cout << getCurrentTimestamp() << " | " << threadInfo
-             << " | Порівняння #" << comparisons << ": "
-             << array[j] << " та " << array[j + 1] << endl;
-      }
-
-      if (array[j] > array[j + 1])
-      {
-        if (verbose)
-        {
-          lock_guard<mutex> lock(consoleMutex);
-          cout << getCurrentTimestamp() << " | " << threadInfo
-               << " | Обмін #" << swaps + 1 << ": "
-               << array[j] << " <-> " << array[j + 1]
-               << " (індекси " << j << " <-> " << j + 1 << ")" << endl;
-        }
-
-        swap(array[j], array[j + 1]);
-        swaps++;
-      }
-    }
+  // Менші частини не окупають запуск задачі в пулі
+  return static_cast<int>(max<size_t>(1, min<size_t>(numThreads, size / MIN_SCAN_CHUNK)));
+}
 
-    if (verbose && (i - start + 1) % 10 == 0)
-    { // Інформація про прогрес кожні 10 ітерацій
-      lock_guard<mutex> lock(consoleMutex);
-      cout << getCurrentTimestamp() << " | " << threadInfo
-           << " | Прогрес: " << (i - start + 1) << "/" << (end - start - 1)
-           << " ітерацій (" << (i - start + 1) * 100 / (end - start - 1) << "%), "
-           << comparisons << " порівнянь, " << swaps << " обмінів" << endl;
-    }
-  }
+SortMetrics ArrayOperations::bubbleSortMultithreaded(vector<int> &array, int numThreads, bool verbose)
+{
+  return bubbleSortMultithreaded(array, numThreads, verbose ? Instrumentation::Trace : Instrumentation::Counters);
+}
 
-  if (verbose)
-  {
-    lock_guard<mutex> lock(consoleMutex);
-    cout << getCurrentTimestamp() << " | " << threadInfo << " | Завершено сортування діапазону ["
-         << start << " - " << end << "), " << comparisons << " порівнянь, "
-         << swaps << " обмінів" << endl;
-  }
+SortMetrics ArrayOperations::oddEvenSortMultithreaded(vector<int> &array, int numThreads, bool verbose)
+{
+  return oddEvenSortMultithreaded(array, numThreads, verbose ? Instrumentation::Trace : Instrumentation::Counters);
 }
 
-// Helper function to merge sorted segments
-void ArrayOperations::mergeSortedSegments(vector<int> &array, int numSegments, long long &comparisons, long long &swaps, bool verbose)
+string ArrayOperations::instrumentationName(Instrumentation instrumentation)
 {
-  int n = array.size();
-  int segmentSize = n / numSegments;
+  switch (instrumentation)
+  {
+  case Instrumentation::None:
+    return "none";
+  case Instrumentation::Counters:
+    return "counters";
+  case Instrumentation::Trace:
+    return "trace";
+  case Instrumentation::Timeline:
+    return "timeline";
+  }
+  return "unknown";
+}
 
-  if (verbose)
-  {
-    cout << getCurrentTimestamp() << " | Злиття | Початок злиття "
-         << numSegments << " сегментів розміром ~" << segmentSize << " елементів" << endl;
-  }
+// Значення апаратного лічильника або "-", якщо подія не рахувалась
+static string formatCounter(long long value)
+{
+  return value < 0 ? "-" : to_string(value);
+}
 
-  vector<int> tempArray(n);
+static string formatIpc(double ipc)
+{
+  if (ipc < 0)
+    return "-";
+  stringstream ss;
+  ss << fixed << setprecision(2) << ipc;
+  return ss.str();
+}
 
-  // Merge each pair of adjacent segments
-  for (int segmentLength = segmentSize; segmentLength < n; segmentLength *= 2)
+static void printHardwareCounters(const HardwareCounterReport &report)
+{
+  if (!report.available)
   {
-    if (verbose)
+    if (!report.unavailableReason.empty())
     {
-      cout << getCurrentTimestamp() << " | Злиття | Обробка сегментів розміром " << segmentLength << endl;
-    }
-
-    for (int start = 0; start < n; start += 2 * segmentLength)
-    {
-      int mid = min(start + segmentLength, n);
-      int end = min(start + 2 * segmentLength, n);
-
-      if (verbose)
-      {
-        cout << getCurrentTimestamp() << " | Злиття | Злиття сегментів ["
-             << start << "-" << mid << ") та [" << mid << "-" << end << ")" << endl;
-      }
-
-      // Merge two segments
-      int i = start, j = mid, k = start;
-
-      while (i < mid && j < end)
-      {
-        comparisons++;
-
-        if (array[i] <= array[j])
-        {
-          tempArray[k++] = array[i++];
-        }
-        else
-        {
-          if (verbose && swaps % 100 == 0)
-          { // Обмежуємо кількість виведень
-            cout << getCurrentTimestamp() << " | Злиття | Переміщення елемента з правого сегмента: "
-                 << array[j] << " (індекс " << j << ") -> позиція " << k << endl;
-          }
-
-          tempArray[k++] = array[j++];
-          swaps++; // Count non-adjacent swaps
-        }
-      }
-
-      // Copy remaining elements
-      while (i < mid)
-      {
-        tempArray[k++] = array[i++];
-      }
-
-      while (j < end)
-      {
-        tempArray[k++] = array[j++];
-      }
-
-      // Copy back to original array
-      for (int m = start; m < end; m++)
-      {
-        array[m] = tempArray[m];
-      }
-
-      if (verbose)
-      {
-        cout << getCurrentTimestamp() << " | Злиття | Завершено злиття сегментів ["
-             << start << "-" << mid << ") та [" << mid << "-" << end << ")" << endl;
-      }
+      cout << "Апаратні лічильники недоступні: " << report.unavailableReason << endl;
     }
+    return;
   }
 
-  if (verbose)
+  cout << "Апаратні лічильники (user-space):" << endl;
+  // Ширина setw рахується в байтах, тому кириличні підписи вирівнюються за кількістю символів
+  auto padLabel = [](const string &label)
   {
-    cout << getCurrentTimestamp() << " | Злиття | Завершено злиття всіх сегментів, "
-         << comparisons << " порівнянь, " << swaps << " обмінів" << endl;
+    int visible = 0;
+    for (char c : label)
+      visible += (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+    return label + string(max(0, 10 - visible), ' ');
+  };
+
+  cout << padLabel("  Потік") << right << setw(15) << "cycles" << setw(15) << "instructions" << setw(7) << "IPC"
+       << setw(13) << "branch-miss" << setw(13) << "L1d-miss" << setw(13) << "LLC-miss" << setw(13) << "dTLB-miss" << endl;
+
+  auto printRow = [&padLabel](const string &label, const HardwareCounts &counts)
+  {
+    cout << padLabel(label) << right
+         << setw(15) << formatCounter(counts.get(HardwareEvent::Cycles))
+         << setw(15) << formatCounter(counts.get(HardwareEvent::Instructions))
+         << setw(7) << formatIpc(counts.ipc())
+         << setw(13) << formatCounter(counts.get(HardwareEvent::BranchMisses))
+         << setw(13) << formatCounter(counts.get(HardwareEvent::L1dMisses))
+         << setw(13) << formatCounter(counts.get(HardwareEvent::LlcMisses))
+         << setw(13) << formatCounter(counts.get(HardwareEvent::DtlbMisses)) << endl;
+  };
+
+  // Робітники пулу, які не виконували роботи під час сортування, не показуються
+  for (const auto &counts : report.perThread)
+  {
+    bool active = false;
+    for (long long value : counts.values)
+      active = active || value > 0;
+    if (active)
+      printRow("  " + to_string(counts.threadId), counts);
   }
+  printRow("  Разом", report.total);
 }
 
-SortMetrics ArrayOperations::bubbleSortMultithreaded(vector<int> &array, int numThreads, bool verbose)
+static void printParallelProfile(const ParallelProfile &profile)
 {
-  SortMetrics metrics;
+  if (!profile.recorded)
+    return;
 
-  // Calculate initial memory usage
-  metrics.memoryUsageBytes = calculateMemoryUsage(array);
+  cout << fixed << setprecision(3);
+  cout << "Фази (мс): підготовка " << profile.setupMs << ", сортування сегментів " << profile.sortMs
+       << " (з них запуск робітників " << profile.spawnMs << "), злиття " << profile.mergeMs
+       << ", очікування завершення " << profile.joinMs << ", підсумки " << profile.finalizeMs << endl;
 
-  if (verbose)
+  cout << "  Робітник    сортування (мс)    злиття (мс)    CPU задач (мс)    CPU всього (мс)" << endl;
+  for (size_t w = 0; w < profile.threadSortMs.size(); w++)
   {
-    cout << "\n=== ДЕТАЛЬНИЙ РЕЖИМ: БАГАТОПОТОКОВЕ СОРТУВАННЯ ===\n";
-    cout << getCurrentTimestamp() << " | Початок багатопотокового сортування масиву розміром "
-         << array.size() << " елементів" << endl;
+    cout << right << setw(10) << w
+         << setw(19) << profile.threadSortMs[w]
+         << setw(15) << profile.threadMergeMs[w]
+         << setw(18) << profile.threadTaskCpuMs[w]
+         << setw(19) << profile.threadCpuMs[w] << endl;
   }
 
-  // Start timing
-  auto startTime = chrono::high_resolution_clock::now();
-
-  // Determine number of threads if not specified
-  if (numThreads <= 0)
+  cout << "Нерівномірність навантаження (max/середнє): " << profile.loadImbalance
+       << ", паралельна ефективність: " << setprecision(1) << profile.parallelEfficiency * 100 << "%";
+  if (profile.threadSortMs.size() > 1)
   {
-    numThreads = thread::hardware_concurrency();
-    if (numThreads == 0)
-      numThreads = 4; // Default to 4 if hardware_concurrency returns 0
+    cout << ", послідовна частка (Карп-Флатт): " << setprecision(3) << profile.serialFraction;
   }
+  cout << endl;
+}
 
-  int n = array.size();
+void ArrayOperations::printMetrics(const SortMetrics &metrics)
+{
+  cout << "=== Метрики сортування ===" << endl;
 
-  // Limit number of threads based on array size
-  int maxThreads = max(1, n / 1000);
-  if (numThreads > maxThreads)
+  auto it = metrics.additionalInfo.find("instrumentation");
+  if (it != metrics.additionalInfo.end() && it->second == instrumentationName(Instrumentation::None))
   {
-    if (verbose)
-    {
-      cout << getCurrentTimestamp() << " | Увага: кількість потоків зменшено з " << numThreads
-           << " до " << maxThreads << " через малий розмір масиву (" << n << " елементів)." << endl;
-    }
-    else
-    {
-      cout << "Увага: кількість потоків зменшено з " << numThreads << " до " << maxThreads
-           << " через малий розмір масиву (" << n << " елементів)." << endl;
-    }
-    numThreads = maxThreads;
+    cout << "Кількість порівнянь: не підраховувалась" << endl;
+    cout << "Кількість обмінів: не підраховувалась" << endl;
   }
-
-  // Print information about threads
-  if (verbose)
+  else
   {
-    cout << getCurrentTimestamp() << " | Сортування на " << numThreads << " потоках" << endl;
+    // Лічильники, що охоплюють лише частину сортування, позначаються
+    auto scope = metrics.additionalInfo.find("counterScope");
+    string scopeNote = scope != metrics.additionalInfo.end() && scope->second == "merge" ? " (лише злиття)" : "";
+    cout << "Кількість порівнянь" << scopeNote << ": " << metrics.comparisons << endl;
+    cout << "Кількість обмінів" << scopeNote << ": " << metrics.swaps << endl;
   }
-  else
+  cout << "Час виконання: " << fixed << setprecision(3) << metrics.executionTimeMs << " мс" << endl;
+  cout << "Використана пам'ять: " << metrics.memoryUsageBytes << " байт" << endl;
+  cout << "Пік додаткових виділень heap: " << metrics.memory.peakHeapBytes << " байт ("
+       << metrics.memory.allocations << " виділень)" << endl;
+  if (metrics.memory.peakRssBytes > 0)
   {
-    cout << "Виконання сортування на " << numThreads << " потоках..." << endl;
+    cout << "Пік RSS процесу: " << metrics.memory.peakRssBytes / 1024 << " КБ, приріст під час сортування: "
+         << (metrics.memory.rssPeakExact ? "" : "щонайменше ") << metrics.memory.peakRssDeltaBytes / 1024 << " КБ" << endl;
   }
 
-  if (numThreads == 1 && !verbose)
+  // Print additional info if available
+  it = metrics.additionalInfo.find("arrayCopyBytes");
+  if (it != metrics.additionalInfo.end())
   {
-    cout << "Використовується один потік. Багатопотокові переваги не будуть помітні." << endl;
+    cout << "Копія масиву перед сортуванням: " << it->second << " байт" << endl;
   }
 
-  // Calculate segment size per thread
-  int segmentSize = n / numThreads;
-  if (verbose)
+  it = metrics.additionalInfo.find("numThreads");
+  if (it != metrics.additionalInfo.end())
   {
-    cout << getCurrentTimestamp() << " | Розмір сегменту на потік: ~" << segmentSize << " елементів" << endl;
+    cout << "Кількість потоків: " << it->second << endl;
   }
-  else
+
+  it = metrics.additionalInfo.find("seed");
+  if (it != metrics.additionalInfo.end())
   {
-    cout << "Розмір сегменту на потік: ~" << segmentSize << " елементів" << endl;
+    cout << "Seed вхідного масиву: " << it->second << endl;
   }
 
-  vector<thread> threads;
-  vector<long long> threadComparisons(numThreads, 0);
-  vector<long long> threadSwaps(numThreads, 0);
-
-  // Create and start threads
-  if (verbose)
+  it = metrics.additionalInfo.find("distribution");
+  if (it != metrics.additionalInfo.end())
   {
-    cout << getCurrentTimestamp() << " | Створення та запуск " << numThreads << " потоків" << endl;
+    cout << "Розподіл вхідного масиву: " << it->second << endl;
   }
 
-  for (int i = 0; i < numThreads; i++)
+  it = metrics.additionalInfo.find("outputSorted");
+  if (it != metrics.additionalInfo.end())
   {
-    int startIdx = i * segmentSize;
-    int endIdx = (i == numThreads - 1) ? n : (i + 1) * segmentSize;
-
-    if (verbose)
+    if (it->second == "true")
     {
-      cout << getCurrentTimestamp() << " | Запуск потоку #" << i << " для сортування діапазону ["
-           << startIdx << " - " << endIdx << ")" << endl;
+      cout << "Перевірка результату: відсортований";
     }
-
-    threads.push_back(thread(
-        [&array, startIdx, endIdx, &threadComparisons, &threadSwaps, i, verbose]()
-        {
-          // Run bubble sort on a segment
-          long long comparisons = 0;
-          long long swaps = 0;
-
-          bubbleSortRange(array, startIdx, endIdx, comparisons, swaps, verbose, i);
-
-          threadComparisons[i] = comparisons;
-          threadSwaps[i] = swaps;
-        }));
-  }
-
-  // Wait for all threads to finish
-  for (int i = 0; i < numThreads; i++)
-  {
-    threads[i].join();
-
-    if (verbose)
+    else
     {
-      cout << getCurrentTimestamp() << " | Потік #" << i << " завершив роботу" << endl;
+      cout << "Перевірка результату: НЕ відсортований, перше порушення порядку на індексі "
+           << metrics.additionalInfo.at("outputFirstUnsorted");
     }
+    cout << " (серій: " << metrics.additionalInfo.at("outputRuns") << ", різних значень: ~"
+         << metrics.additionalInfo.at("outputDistinct") << ", сканування " << metrics.additionalInfo.at("outputScanMs") << " мс)" << endl;
   }
 
-  // Sum up comparisons and swaps from all threads
-  for (int i = 0; i < numThreads; i++)
+  it = metrics.additionalInfo.find("autoAlgorithm");
+  if (it != metrics.additionalInfo.end())
   {
-    metrics.comparisons += threadComparisons[i];
-    metrics.swaps += threadSwaps[i];
-
-    if (verbose)
-    {
-      cout << getCurrentTimestamp() << " | Метрики потоку #" << i
-           << ": " << threadComparisons[i] << " порівнянь, "
-           << threadSwaps[i] << " обмінів" << endl;
-    }
+    cout << "Автоматичний вибір: " << it->second << ", потоків: " << metrics.additionalInfo.at("autoThreads")
+         << " (оцінка " << metrics.additionalInfo.at("autoEstimatedMs") << " мс, аналіз входу "
+         << metrics.additionalInfo.at("autoProfileMs") << " мс)" << endl;
+    cout << "Причини вибору: " << metrics.additionalInfo.at("autoReason") << endl;
   }
 
-  // Merge the sorted segments
-  if (numThreads > 1)
+  it = metrics.additionalInfo.find("valueMin");
+  if (it != metrics.additionalInfo.end())
   {
-    if (verbose)
-    {
-      cout << getCurrentTimestamp() << " | Початок об'єднання " << numThreads << " відсортованих сегментів" << endl;
-    }
-    else
-    {
-      cout << "Об'єднання " << numThreads << " відсортованих сегментів..." << endl;
-    }
-
-    long long mergeComparisons = 0;
-    long long mergeSwaps = 0;
-    mergeSortedSegments(array, numThreads, mergeComparisons, mergeSwaps, verbose);
-
-    // Add merging operations to metrics
-    metrics.comparisons += mergeComparisons;
-    metrics.swaps += mergeSwaps;
-
-    if (verbose)
+    cout << "Діапазон значень: [" << it->second << ", " << metrics.additionalInfo.at("valueMax") << "]";
+    auto distinct = metrics.additionalInfo.find("distinctValues");
+    if (distinct != metrics.additionalInfo.end())
     {
-      cout << getCurrentTimestamp() << " | Завершено об'єднання сегментів: "
-           << mergeComparisons << " порівнянь, " << mergeSwaps << " обмінів" << endl;
+      cout << ", різних значень: " << distinct->second;
     }
+    cout << endl;
   }
 
-  // End timing
-  auto endTime = chrono::high_resolution_clock::now();
-  metrics.executionTimeMs = chrono::duration<double, milli>(endTime - startTime).count();
-
-  // Also return the number of threads used
-  metrics.additionalInfo["numThreads"] = to_string(numThreads);
-
-  if (verbose)
+  it = metrics.additionalInfo.find("sortPath");
+  if (it != metrics.additionalInfo.end())
   {
-    cout << getCurrentTimestamp() << " | Сортування завершено за "
-         << fixed << setprecision(3) << metrics.executionTimeMs << " мс" << endl;
-    cout << "=== КІНЕЦЬ ДЕТАЛЬНОГО РЕЖИМУ ===\n"
-         << endl;
+    cout << "Шлях сортування: " << it->second << endl;
   }
 
-  return metrics;
-}
-
-void ArrayOperations::printArray(const vector<int> &array, int maxElements)
-{
-  int size = array.size();
-
-  if (size <= maxElements)
+  it = metrics.additionalInfo.find("segmentKernel");
+  if (it != metrics.additionalInfo.end())
   {
-    // Print full array if it's small enough
-    for (int value : array)
-    {
-      cout << value << " ";
-    }
+    cout << "Ядро сортування сегментів: " << it->second << endl;
   }
-  else
-  {
-    // Print truncated array with indicators
-    int halfMax = maxElements / 2;
-
-    // Print first half of the elements
-    for (int i = 0; i < halfMax; i++)
-    {
-      cout << array[i] << " ";
-    }
 
-    // Print ellipsis to indicate truncation
-    cout << "... [" << (size - maxElements) << " елементів пропущено] ... ";
-
-    // Print last half of the elements
-    for (int i = size - halfMax; i < size; i++)
-    {
-      cout << array[i] << " ";
-    }
+  it = metrics.additionalInfo.find("sortPhaseMs");
+  if (it != metrics.additionalInfo.end())
+  {
+    cout << "Фаза сортування сегментів: " << it->second << " мс" << endl;
   }
-  cout << endl;
-}
-
-size_t ArrayOperations::calculateMemoryUsage(const vector<int> &array)
-{
-  // Calculate memory usage (vector size + overhead)
-  return array.size() * sizeof(int) + sizeof(vector<int>);
-}
-
-void ArrayOperations::printMetrics(const SortMetrics &metrics)
-{
-  cout << "=== Метрики сортування ===" << endl;
-  cout << "Кількість порівнянь: " << metrics.comparisons << endl;
-  cout << "Кількість обмінів: " << metrics.swaps << endl;
-  cout << "Час виконання: " << fixed << setprecision(3) << metrics.executionTimeMs << " мс" << endl;
-  cout << "Використана пам'ять: " << metrics.memoryUsageBytes << " байт" << endl;
 
-  // Print additional info if available
-  auto it = metrics.additionalInfo.find("numThreads");
+  it = metrics.additionalInfo.find("mergePhaseMs");
   if (it != metrics.additionalInfo.end())
   {
-    cout << "Кількість потоків: " << it->second << endl;
+    cout << "Фаза злиття: " << it->second << " мс" << endl;
   }
-}
 
-SortMetrics ArrayOperations::bubbleSort(vector<int> &array, bool verbose)
-{
-  SortMetrics metrics;
+  it = metrics.additionalInfo.find("steals");
+  if (it != metrics.additionalInfo.end())
+  {
+    cout << "Вкрадених задач: " << it->second << endl;
+  }
 
-  // Calculate initial memory usage
-  metrics.memoryUsageBytes = calculateMemoryUsage(array);
+  printParallelProfile(metrics.parallel);
 
-  if (verbose)
+  it = metrics.additionalInfo.find("poolTasks");
+  if (it != metrics.additionalInfo.end())
   {
-    cout << "\n=== ДЕТАЛЬНИЙ РЕЖИМ: ПОСЛІДОВНЕ СОРТУВАННЯ ===\n";
-    cout << getCurrentTimestamp() << " | Початок послідовного сортування масиву розміром "
-         << array.size() << " елементів" << endl;
+    cout << "Задач виконано пулом потоків: " << it->second
+         << " (простій робітників: " << metrics.additionalInfo.at("poolIdleMs") << " мс)" << endl;
   }
 
-  // Start timing
-  auto startTime = chrono::high_resolution_clock::now();
+  it = metrics.additionalInfo.find("variant");
+  if (it != metrics.additionalInfo.end())
+  {
+    cout << "Варіант: " << it->second << ", проходів: " << metrics.additionalInfo.at("passes") << endl;
+  }
 
-  int n = array.size();
-  for (int i = 0; i < n - 1; i++)
+  it = metrics.additionalInfo.find("radixPasses");
+  if (it != metrics.additionalInfo.end())
   {
-    for (int j = 0; j < n - i - 1; j++)
-    {
-      metrics.comparisons++; // Count comparison
-
-      if (verbose && metrics.comparisons % 1000 == 0)
-      { // Обмежуємо кількість виведень
-        cout << getCurrentTimestamp() << " | Порівняння #" << metrics.comparisons
-             << ": " << array[j] << " та " << array[j + 1] << endl;
-      }
-
-      if (array[j] > array[j + 1])
-      {
-        // Swap array[j] and array[j+1]
-        if (verbose)
-        {
-          cout << getCurrentTimestamp() << " | Обмін #" << metrics.swaps + 1
-               << ": " << array[j] << " <-> " << array[j + 1]
-               << " (індекси " << j << " <-> " << j + 1 << ")" << endl;
-        }
-
-        swap(array[j], array[j + 1]);
-        metrics.swaps++; // Count swap
-      }
-    }
+    cout << "Розрядних проходів: " << it->second << " по " << metrics.additionalInfo.at("radixDigitBits")
+         << " біт (пропущено проходів з однаковою цифрою: " << metrics.additionalInfo.at("radixSkippedPasses") << ")" << endl;
+  }
 
-    if (verbose && (i + 1) % 10 == 0)
-    { // Інформація про прогрес кожні 10 ітерацій
-      cout << getCurrentTimestamp() << " | Прогрес: " << (i + 1) << "/" << (n - 1)
-           << " ітерацій (" << (i + 1) * 100 / (n - 1) << "%), "
-           << metrics.comparisons << " порівнянь, " << metrics.swaps << " обмінів" << endl;
-    }
+  it = metrics.additionalInfo.find("rounds");
+  if (it != metrics.additionalInfo.end())
+  {
+    cout << "Кількість раундів: " << it->second << endl;
   }
 
-  // End timing
-  auto endTime = chrono::high_resolution_clock::now();
-  metrics.executionTimeMs = chrono::duration<double, milli>(endTime - startTime).count();
+  it = metrics.additionalInfo.find("traceEvents");
+  if (it != metrics.additionalInfo.end())
+  {
+    cout << "Подій часової шкали: " << it->second << " (втрачено через переповнення буфера: "
+         << metrics.additionalInfo.at("traceDropped") << ")" << endl;
+  }
 
-  if (verbose)
+  it = metrics.additionalInfo.find("runs");
+  if (it != metrics.additionalInfo.end())
   {
-    cout << getCurrentTimestamp() << " | Сортування завершено за "
-         << fixed << setprecision(3) << metrics.executionTimeMs << " мс" << endl;
-    cout << "=== КІНЕЦЬ ДЕТАЛЬНОГО РЕЖИМУ ===\n"
-         << endl;
+    cout << "Серій на диску: " << it->second << ", проходів злиття: " << metrics.additionalInfo.at("mergePasses")
+         << ", обсяг вводу-виводу: " << stoull(metrics.additionalInfo.at("ioBytes")) / (1024.0 * 1024.0) << " МБ"
+         << " (бюджет пам'яті: " << stoull(metrics.additionalInfo.at("memoryBudget")) / (1024 * 1024) << " МБ)" << endl;
   }
 
-  return metrics;
+  printHardwareCounters(metrics.hardwareCounters);
 }
 
-bool ArrayOperations::isSorted(const vector<int> &array)
+SortMetrics ArrayOperations::bubbleSort(vector<int> &array, bool verbose)
 {
-  if (array.empty() || array.size() == 1)
-  {
-    return true; // Порожній масив або масив з одного елемента вважається відсортованим
-  }
+  return bubbleSort(array, verbose ? Instrumentation::Trace : Instrumentation::Counters);
+}
 
-  for (size_t i = 1; i < array.size(); i++)
+bool ArrayOperations::isNarrowRange(const ValueRange &range, int size)
+{
+  // Підрахунок окупається, лише коли кошиків не більше, ніж елементів
+  return !range.empty && range.span() < static_cast<unsigned long long>(COUNTING_SORT_MAX_RANGE) &&
+         range.span() < static_cast<unsigned long long>(size);
+}
+
+string ArrayOperations::bubbleVariantName(BubbleVariant variant)
+{
+  switch (variant)
   {
-    if (array[i] < array[i - 1])
-    {
-      return false;
-    }
+  case BubbleVariant::EarlyExit:
+    return "early-exit";
+  case BubbleVariant::CocktailShaker:
+    return "cocktail";
+  case BubbleVariant::Comb:
+    return "comb";
   }
+  return "unknown";
+}
 
-  return true;
-}
\ No newline at end of file
+// Рушії компілюються для кожного вбудованого типу елементів окремо, щоб внутрішні цикли
+// були мономорфними і вбудовувались
+#define ARRAY_OPERATIONS_INSTANTIATE(T, Less)                                                                             \
+  template SortMetrics ArrayOperations::bubbleSort<T, Less>(vector<T> &, Instrumentation, FastPath, const Less &);        \
+  template SortMetrics ArrayOperations::adaptiveBubbleSort<T, Less>(vector<T> &, BubbleVariant, Instrumentation, const Less &); \
+  template SortMetrics ArrayOperations::bubbleSortMultithreaded<T, Less>(vector<T> &, int, Instrumentation, SegmentKernel, FastPath, const Less &); \
+  template SortMetrics ArrayOperations::oddEvenSortMultithreaded<T, Less>(vector<T> &, int, Instrumentation, const Less &); \
+  template bool ArrayOperations::isSorted<T, Less>(const vector<T> &, const Less &);                                      \
+  template size_t ArrayOperations::findFirstUnsorted<T, Less>(const vector<T> &, const Less &, int);                      \
+  template void ArrayOperations::printArray<T>(const vector<T> &, int);                                                   \
+  template size_t ArrayOperations::calculateMemoryUsage<T>(const vector<T> &);
+
+// Числові типи мають також завантаження і збереження файлів
+#define ARRAY_OPERATIONS_INSTANTIATE_NUMERIC(T)                                                                  \
+  ARRAY_OPERATIONS_INSTANTIATE(T, NaturalOrder<T>)                                                               \
+  template void ArrayOperations::saveArrayToFile<T>(const vector<T> &, const string &, ArrayFileFormat, IoStats *); \
+  template vector<T> ArrayOperations::loadArrayFromFile<T>(const string &, IoStats *);                            \
+  template ArrayStatistics<T> ArrayOperations::scanArray<T>(const vector<T> &, int);                               \
+  template void ArrayOperations::recordStatistics<T>(SortMetrics &, const ArrayStatistics<T> &);
+
+ARRAY_OPERATIONS_INSTANTIATE_NUMERIC(int32_t)
+ARRAY_OPERATIONS_INSTANTIATE_NUMERIC(int64_t)
+template SortMetrics ArrayOperations::radixSort<int32_t>(vector<int32_t> &, int, Instrumentation);
+template SortMetrics ArrayOperations::radixSort<int64_t>(vector<int64_t> &, int, Instrumentation);
+template ValueRange ArrayOperations::detectValueRange<int32_t>(const vector<int32_t> &, int);
+template ValueRange ArrayOperations::detectValueRange<int64_t>(const vector<int64_t> &, int);
+ARRAY_OPERATIONS_INSTANTIATE_NUMERIC(float)
+ARRAY_OPERATIONS_INSTANTIATE_NUMERIC(double)
+
+// Записи (ключ int64, наприклад мітка часу, і корисне навантаження) за ключем
+typedef Record<int64_t, int64_t> TimestampRecord;
+ARRAY_OPERATIONS_INSTANTIATE(TimestampRecord, KeyOrder<RecordKey>)
+
+#undef ARRAY_OPERATIONS_INSTANTIATE_NUMERIC
+#undef ARRAY_OPERATIONS_INSTANTIATE
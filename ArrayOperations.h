@@ -6,56 +6,288 @@
 #include <chrono>
 #include <thread>
 #include <map>
+#include "ThreadPool.h"
+#include "ArrayFileIO.h"
+#include "ArrayGenerator.h"
+#include "HardwareCounters.h"
+#include "MemoryTracker.h"
+#include "WorkStealingScheduler.h"
+#include "ElementOrder.h"
 
 using namespace std;
 
+// Phase breakdown of a parallel sort. Wall-clock phases are measured from
+// the start of the sort on the calling thread; per-thread vectors are indexed
+// by worker.
+struct ParallelProfile
+{
+  bool recorded;
+  double setupMs;            // Поділ на сегменти, буфери, створення задач
+  double spawnMs;            // Від запуску планувальника до старту останнього робітника (входить у фазу сортування)
+  double sortMs;             // Від запуску планувальника до завершення останнього сегмента
+  double mergeMs;            // Від завершення сортування до завершення останнього робітника
+  double joinMs;             // Від завершення останнього робітника до повернення з планувальника
+  double finalizeMs;         // Обмін буферів і підсумки
+  vector<double> threadSortMs;  // Час сортування сегментів кожним робітником
+  vector<double> threadMergeMs; // Час злиття кожним робітником
+  vector<double> threadTaskCpuMs; // Процесорний час задач робітника (CLOCK_THREAD_CPUTIME_ID)
+  vector<double> threadCpuMs;   // Процесорний час робітника разом з очікуванням задач
+  double loadImbalance;      // Максимальний процесорний час задач потоку / середній
+  double parallelEfficiency; // Сумарний процесорний час задач / (потоки * загальний час)
+  double serialFraction;     // Метрика Карпа-Флатта; -1 для одного потоку
+
+  ParallelProfile()
+      : recorded(false), setupMs(0), spawnMs(0), sortMs(0), mergeMs(0), joinMs(0), finalizeMs(0),
+        loadImbalance(1.0), parallelEfficiency(0), serialFraction(-1) {}
+};
+
 struct SortMetrics
 {
   long long comparisons;
   long long swaps;
   double executionTimeMs;
-  size_t memoryUsageBytes;
-  map<string, string> additionalInfo; // Додаткова інформація (ключ-значення)
+  size_t memoryUsageBytes;                // Вхідний масив + пік додаткових виділень під час сортування
+  map<string, string> additionalInfo;     // Додаткова інформація (ключ-значення)
+  HardwareCounterReport hardwareCounters; // Апаратні лічильники perf (по потоках і сумарно)
+  MemoryUsage memory;                     // Виміряна пам'ять: пік heap і RSS
+  ParallelProfile parallel;               // Фази і завантаження потоків паралельного сортування
 
   SortMetrics() : comparisons(0), swaps(0), executionTimeMs(0), memoryUsageBytes(0) {}
 };
 
+// How much a sort kernel observes itself: nothing, comparison/swap counters,
+// counters plus detailed console trace, or counters plus a per-thread event
+// timeline written as a Chrome trace (EventTracer.h)
+enum class Instrumentation
+{
+  None,
+  Counters,
+  Trace,
+  Timeline
+};
+
+// Kernel used for the per-thread segments of the multithreaded sort
+enum class SegmentKernel
+{
+  Bubble, // Bubble sort (the reference algorithm)
+  Simd    // Vectorized sorting network + bitonic merge (see SimdSort.h)
+};
+
+// Adaptive exchange sorts built on branchless compare-exchange
+enum class BubbleVariant
+{
+  EarlyExit,      // Bubble sort with last-swap bound and early termination
+  CocktailShaker, // Bidirectional passes shrinking from both ends
+  Comb            // Shrinking gap, finishing with gap-1 passes
+};
+
+// Whether bubbleSort and bubbleSortMultithreaded may sort integer arrays with
+// a narrow value range by counting instead of running their own algorithm
+enum class FastPath
+{
+  Auto,    // Counting sort when the range is narrow enough
+  Disabled // Always the engine's own algorithm (for measuring it)
+};
+
+// Smallest and largest value of an integer array
+struct ValueRange
+{
+  bool empty;
+  long long minValue;
+  long long maxValue;
+
+  ValueRange() : empty(true), minValue(0), maxValue(0) {}
+
+  // Number of possible values minus one; does not overflow for int64
+  unsigned long long span() const { return static_cast<unsigned long long>(maxValue) - static_cast<unsigned long long>(minValue); }
+};
+
+// Statistics of an array from one parallel scan (ArrayOperations::scanArray),
+// in the natural order of T. Integer sums are accumulated in long long, so
+// int64 sums wrap around on overflow.
+template <typename T>
+struct ArrayStatistics
+{
+  typedef typename conditional<is_integral<T>::value, long long, double>::type Sum;
+
+  size_t size;
+  bool sorted;               // Неспадний порядок
+  size_t firstUnsortedIndex; // Перший i з array[i] < array[i - 1]; size, якщо масив відсортований
+  size_t runCount;           // Неспадних серій (0 для порожнього масиву)
+  T minValue;                // Мінімум і максимум - лише для непорожнього масиву
+  T maxValue;
+  Sum sum;
+  double distinctEstimate;   // Оцінка кількості різних значень (HyperLogLog, похибка ~1.6%)
+  double scanMs;             // Час сканування
+
+  ArrayStatistics()
+      : size(0), sorted(true), firstUnsortedIndex(0), runCount(0), minValue(), maxValue(), sum(),
+        distinctEstimate(0), scanMs(0) {}
+};
+
+// Sort engines with metrics. The engines, loaders and helpers are templates
+// over the element type T and a strict weak order Less (NaturalOrder<T> by
+// default, KeyOrder<...> to sort records by a key, see ElementOrder.h); their
+// definitions are in ArrayOperationsImpl.h. ArrayOperations.cpp instantiates
+// them for int32_t, int64_t, float, double and Record<int64_t, int64_t> by key,
+// so each type has its own inlined kernels; other types need to include
+// ArrayOperationsImpl.h.
 class ArrayOperations
 {
 public:
-  // Generate random array of given size
+  // Generate random array of given size (seeded from random_device)
   static vector<int> generateRandomArray(int size, int minValue = 0, int maxValue = 100);
 
+  // Generate random array from an explicit seed. Element i depends only on
+  // (seed, i) through the Philox counter-based generator, so the array is
+  // filled in parallel and is identical for any number of threads.
+  static vector<int> generateRandomArray(int size, int minValue, int maxValue, uint64_t seed);
+
+  // Generate array of the given shape (see Distribution) from an explicit seed;
+  // numThreads limits the generating threads (0 - every pool worker)
+  static vector<int> generateArray(int size, Distribution distribution, const DistributionParams &params, uint64_t seed, int numThreads = 0);
+
+  // Fresh seed from random_device
+  static uint64_t randomSeed();
+
   // Save array to file
-  static void saveArrayToFile(const vector<int> &array, const string &filename);
+  template <typename T>
+  static void saveArrayToFile(const vector<T> &array, const string &filename, ArrayFileFormat format = ArrayFileFormat::Text, IoStats *stats = nullptr);
 
-  // Load array from file
-  static vector<int> loadArrayFromFile(const string &filename);
+  // Load array from file (text or binary, detected by the magic bytes)
+  template <typename T = int>
+  static vector<T> loadArrayFromFile(const string &filename, IoStats *stats = nullptr);
 
   // Bubble sort implementation with metrics
   static SortMetrics bubbleSort(vector<int> &array, bool verbose = false);
+  template <typename T, typename Less = NaturalOrder<T>>
+  static SortMetrics bubbleSort(vector<T> &array, Instrumentation instrumentation, FastPath fastPath = FastPath::Auto, const Less &less = Less());
+
+  // Adaptive bubble sort family (early exit, cocktail shaker, comb sort) with metrics
+  template <typename T, typename Less = NaturalOrder<T>>
+  static SortMetrics adaptiveBubbleSort(vector<T> &array, BubbleVariant variant, Instrumentation instrumentation = Instrumentation::Counters, const Less &less = Less());
 
-  // Multithreaded bubble sort implementation with metrics
+  // Short name of a bubble variant ("early-exit", "cocktail", "comb")
+  static string bubbleVariantName(BubbleVariant variant);
+
+  // Multithreaded bubble sort implementation with metrics. The SIMD segment
+  // kernel handles int in natural order only; other types use the bubble kernel.
   static SortMetrics bubbleSortMultithreaded(vector<int> &array, int numThreads = 0, bool verbose = false);
+  template <typename T, typename Less = NaturalOrder<T>>
+  static SortMetrics bubbleSortMultithreaded(vector<T> &array, int numThreads, Instrumentation instrumentation, SegmentKernel segmentKernel = SegmentKernel::Bubble, FastPath fastPath = FastPath::Auto, const Less &less = Less());
+
+  // Both bubble engines above first look at integer arrays in natural order
+  // (FastPath::Auto): if max - min < COUNTING_SORT_MAX_RANGE and below the
+  // array size, they sort by counting in O(n + range) instead. The detected
+  // range and the path taken are in additionalInfo ("valueMin", "valueMax",
+  // "distinctValues", "sortPath").
+
+  // Parallel odd-even transposition sort: all threads run alternating
+  // odd/even compare-exchange phases over the whole array
+  static SortMetrics oddEvenSortMultithreaded(vector<int> &array, int numThreads = 0, bool verbose = false);
+  template <typename T, typename Less = NaturalOrder<T>>
+  static SortMetrics oddEvenSortMultithreaded(vector<T> &array, int numThreads, Instrumentation instrumentation, const Less &less = Less());
+
+  // Parallel LSD radix sort of signed integers (int32_t, int64_t): RADIX_BITS-bit
+  // digits from the least significant, per-thread histograms and a stable
+  // prefix-sum scatter between two ping-pong buffers. The sign bit is flipped
+  // in the key, and passes where every element has the same digit are skipped.
+  // Makes no comparisons; the instrumentation only selects trace output.
+  template <typename T>
+  static SortMetrics radixSort(vector<T> &array, int numThreads = 0, Instrumentation instrumentation = Instrumentation::Counters);
+
+  // Digit width of the radix sort: 256 buckets, the per-thread histograms stay in L1
+  static const int RADIX_BITS = 8;
+
+  // Minimum and maximum of an integer array in one parallel read (0 threads = auto)
+  template <typename T>
+  static ValueRange detectValueRange(const vector<T> &array, int numThreads = 0);
+
+  // Whether the bubble engines sort an array of this size and value range by counting
+  static bool isNarrowRange(const ValueRange &range, int size);
+
+  // Widest value range sorted by counting: 64K buckets, 256 KB histogram per thread
+  static const int COUNTING_SORT_MAX_RANGE = 1 << 16;
 
   // Print array to console (with truncation for large arrays)
-  static void printArray(const vector<int> &array, int maxElements = 100);
+  template <typename T>
+  static void printArray(const vector<T> &array, int maxElements = 100);
 
   // Calculate memory usage of array
-  static size_t calculateMemoryUsage(const vector<int> &array);
+  template <typename T>
+  static size_t calculateMemoryUsage(const vector<T> &array);
 
   // Print sort metrics
   static void printMetrics(const SortMetrics &metrics);
 
+  // Short name of an instrumentation level ("none", "counters", "trace", "timeline")
+  static string instrumentationName(Instrumentation instrumentation);
+
   // Verify if array is sorted
-  static bool isSorted(const vector<int> &array);
+  template <typename T, typename Less = NaturalOrder<T>>
+  static bool isSorted(const vector<T> &array, const Less &less = Less());
+
+  // Index of the first element that is less than its predecessor, or
+  // array.size() for a sorted array. Threads scan their parts in blocks whose
+  // comparison loop vectorizes, and stop once a violation at a lower index is
+  // known (0 threads = pool size, at most one per MIN_SCAN_CHUNK elements).
+  template <typename T, typename Less = NaturalOrder<T>>
+  static size_t findFirstUnsorted(const vector<T> &array, const Less &less = Less(), int numThreads = 0);
+
+  // Sortedness with the first violation, run count, min/max, sum and a
+  // distinct-count estimate of a numeric array in one parallel pass
+  template <typename T>
+  static ArrayStatistics<T> scanArray(const vector<T> &array, int numThreads = 0);
+
+  // Store the statistics of a sorted array in metrics.additionalInfo ("output...")
+  template <typename T>
+  static void recordStatistics(SortMetrics &metrics, const ArrayStatistics<T> &stats);
+
+  // Elements per block of the scans: the block is checked by a branchless
+  // loop, and only a block with a violation is searched element by element
+  static const int SCAN_BLOCK = 256;
+
+  // Smallest part of an array scanned by one thread
+  static const int MIN_SCAN_CHUNK = 1 << 16;
 
 private:
+  // Segment sort and merge tasks created per worker thread, so idle workers have something to steal
+  static const int TASKS_PER_THREAD = 4;
+
+  // Resolve requested thread count (0 = auto) and limit it by array size
+  static int resolveThreadCount(int numThreads, int n, bool verbose);
+
+  // Thread count of the scans (0 = pool size), at least MIN_SCAN_CHUNK elements per thread
+  static int scanThreadCount(size_t size, int numThreads);
+
   // Helper function for bubble sort in a specific range
-  static void bubbleSortRange(vector<int> &array, int start, int end, long long &comparisons, long long &swaps, bool verbose = false, int threadId = -1);
+  template <typename T, typename Less>
+  static void bubbleSortRange(vector<T> &array, int start, int end, long long &comparisons, long long &swaps, Instrumentation instrumentation, const Less &less, int threadId = -1);
+
+  // Merge the parts [from[s], to[s]) of sorted segments into out starting at outStart
+  template <typename T, typename Less>
+  static void mergeSegmentSlice(const vector<T> &array, const vector<int> &from, const vector<int> &to, vector<T> &out, int outStart, long long &comparisons, long long &swaps, const Less &less);
+
+  // Find per-segment split positions for a given output rank of the merged sequence
+  template <typename T, typename Less>
+  static vector<int> segmentSplitsForRank(const vector<T> &array, const vector<int> &boundaries, int rank, const Less &less);
+
+  // Counting sort fast path of the bubble engines. Records the value range and
+  // returns true if the array was sorted; the false_type overload is used for
+  // floating point types and custom orders and never sorts.
+  template <typename T>
+  static bool countingSortNarrowRange(vector<T> &array, int numThreads, SortMetrics &metrics, true_type);
+  template <typename T>
+  static bool countingSortNarrowRange(vector<T> &array, int numThreads, SortMetrics &metrics, false_type);
+
+  // Store pool task count and worker idle time accumulated since `before`
+  static void recordPoolStats(SortMetrics &metrics, const ThreadPoolStats &before);
 
-  // Helper function to merge sorted segments
-  static void mergeSortedSegments(vector<int> &array, int numSegments, long long &comparisons, long long &swaps, bool verbose = false);
+  // Fill metrics.parallel from the scheduler statistics and per-worker task times;
+  // phase durations are in milliseconds, metrics.executionTimeMs must be set
+  static void recordParallelProfile(SortMetrics &metrics, double setupMs, double sortMs, double finalizeMs,
+                                    const WorkStealingStats &schedulerStats,
+                                    const vector<double> &threadSortMs, const vector<double> &threadMergeMs);
 
   // Get current timestamp for verbose output
   static string getCurrentTimestamp();
@@ -0,0 +1,1362 @@
+#ifndef ARRAY_OPERATIONS_IMPL_H
+#define ARRAY_OPERATIONS_IMPL_H
+
+// Definitions of the ArrayOperations templates. ArrayOperations.cpp includes
+// this file and instantiates the engines for the built-in element types;
+// code that sorts its own types or comparators includes it as well.
+
+#include "ArrayOperations.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <type_traits>
+#include <cstring>
+#include <sstream>
+#include "SpinBarrier.h"
+#include "SortKernels.h"
+#include "LoserTree.h"
+#include "SimdSort.h"
+#include "EventTracer.h"
+#include "SortMeasurement.h"
+#include "HyperLogLog.h"
+
+// Vectorized segment kernel of the multithreaded sort: only int in natural order
+template <typename T, typename Less>
+struct SimdSegmentKernel
+{
+  static const bool supported = false;
+  static void sort(T *, int) {}
+};
+
+template <>
+struct SimdSegmentKernel<int, NaturalOrder<int>>
+{
+  static const bool supported = true;
+  static void sort(int *data, int n) { SimdSort::sort(data, n); }
+};
+
+// Counting sort fast path of the bubble engines: integers in natural order only
+template <typename T, typename Less>
+struct CountingSortPath : integral_constant<bool, is_integral<T>::value && is_same<Less, NaturalOrder<T>>::value>
+{
+};
+
+template <typename T>
+void ArrayOperations::saveArrayToFile(const vector<T> &array, const string &filename, ArrayFileFormat format, IoStats *stats)
+{
+  if (format == ArrayFileFormat::Binary)
+  {
+    ArrayFileIO::saveBinary(array, filename, stats);
+    cout << "Файл " << filename << " успішно збережено у бінарному форматі. Розмір: " << array.size() << " елементів." << endl;
+    return;
+  }
+
+  ArrayFileIO::saveText(array, filename, stats);
+  cout << "Файл " << filename << " успішно збережено. Розмір: " << array.size() << " елементів." << endl;
+}
+
+template <typename T>
+vector<T> ArrayOperations::loadArrayFromFile(const string &filename, IoStats *stats)
+{
+  if (ArrayFileIO::isBinaryFile(filename))
+  {
+    return ArrayFileIO::loadBinary<T>(filename, stats);
+  }
+
+  return ArrayFileIO::loadText<T>(filename, stats);
+}
+
+// Run a bubble sort kernel with the given instrumentation policy and collect its counters
+template <typename T, typename Less, typename Policy>
+void runBubbleKernel(vector<T> &array, int start, int end, long long &comparisons, long long &swaps, const Less &less, Policy &policy)
+{
+  bubbleSortKernel(array.data(), start, end, less, policy);
+  comparisons += policy.getComparisons();
+  swaps += policy.getSwaps();
+}
+
+// Helper function for bubble sort in a specific range
+template <typename T, typename Less>
+void ArrayOperations::bubbleSortRange(vector<T> &array, int start, int end, long long &comparisons, long long &swaps, Instrumentation instrumentation, const Less &less, int threadId)
+{
+  string threadInfo = threadId >= 0 ? "Потік " + to_string(threadId) : "Основний потік";
+  bool verbose = instrumentation == Instrumentation::Trace;
+
+  if (verbose)
+  {
+    lock_guard<mutex> lock(consoleMutex);
+    cout << getCurrentTimestamp() << " | " << threadInfo << " | Початок сортування діапазону ["
+         << start << " - " << end << ") розміром " << (end - start) << " елементів" << endl;
+  }
+
+  // Рівень інструментування вибирає лише спеціалізацію ядра, а не перевіряється у циклі
+  switch (instrumentation)
+  {
+  case Instrumentation::None:
+  {
+    NoInstrumentation policy;
+    runBubbleKernel(array, start, end, comparisons, swaps, less, policy);
+    break;
+  }
+  case Instrumentation::Counters:
+  {
+    CountingInstrumentation policy;
+    runBubbleKernel(array, start, end, comparisons, swaps, less, policy);
+    break;
+  }
+  case Instrumentation::Trace:
+  {
+    TracingInstrumentation policy(threadInfo + " | ");
+    runBubbleKernel(array, start, end, comparisons, swaps, less, policy);
+    break;
+  }
+  case Instrumentation::Timeline:
+  {
+    TimelineInstrumentation policy;
+    runBubbleKernel(array, start, end, comparisons, swaps, less, policy);
+    break;
+  }
+  }
+
+  if (verbose)
+  {
+    lock_guard<mutex> lock(consoleMutex);
+    cout << getCurrentTimestamp() << " | " << threadInfo << " | Завершено сортування діапазону ["
+         << start << " - " << end << "), " << comparisons << " порівнянь, "
+         << swaps << " обмінів" << endl;
+  }
+}
+
+// Co-rank: for output position `rank` of the merged sequence find how many
+// elements of every segment precede it. Elements are ordered by (value, segment),
+// the same order the loser tree produces, so the split is exact even with duplicates.
+template <typename T, typename Less>
+vector<int> ArrayOperations::segmentSplitsForRank(const vector<T> &array, const vector<int> &boundaries, int rank, const Less &less)
+{
+  int numSegments = static_cast<int>(boundaries.size()) - 1;
+  vector<int> splits(numSegments);
+
+  for (int s = 0; s < numSegments; s++)
+  {
+    int lo = boundaries[s];
+    int hi = boundaries[s + 1];
+
+    // Шукаємо перший елемент сегмента s, глобальний ранг якого >= rank
+    while (lo < hi)
+    {
+      int mid = lo + (hi - lo) / 2;
+      const T &value = array[mid];
+      long long globalRank = mid - boundaries[s];
+
+      for (int other = 0; other < numSegments && globalRank < rank; other++)
+      {
+        if (other == s)
+          continue;
+
+        auto first = array.begin() + boundaries[other];
+        auto last = array.begin() + boundaries[other + 1];
+        // Рівні елементи сегментів з меншим номером ідуть раніше
+        globalRank += (other < s ? upper_bound(first, last, value, less) : lower_bound(first, last, value, less)) - first;
+      }
+
+      if (globalRank < rank)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+    splits[s] = lo;
+  }
+
+  return splits;
+}
+
+// Merge the parts [from[s], to[s]) of all segments into out[outStart...)
+template <typename T, typename Less>
+void ArrayOperations::mergeSegmentSlice(const vector<T> &array, const vector<int> &from, const vector<int> &to, vector<T> &out, int outStart, long long &comparisons, long long &swaps, const Less &less)
+{
+  int numSegments = from.size();
+  vector<int> cursor(from);
+
+  LoserTree<T, Less> tree(numSegments, less);
+  for (int s = 0; s < numSegments; s++)
+  {
+    if (cursor[s] < to[s])
+    {
+      tree.setSource(s, array[cursor[s]]);
+    }
+  }
+  tree.build();
+
+  int k = outStart;
+  while (tree.hasWinner())
+  {
+    int s = tree.winner();
+    int index = cursor[s]++;
+    if (index != k)
+    {
+      swaps++; // Count non-adjacent moves
+    }
+    out[k++] = array[index];
+
+    if (cursor[s] < to[s])
+    {
+      tree.replaceTop(array[cursor[s]]);
+    }
+    else
+    {
+      tree.exhaustTop();
+    }
+  }
+
+  comparisons += tree.getComparisons();
+}
+
+
+template <typename T, typename Less>
+SortMetrics ArrayOperations::bubbleSortMultithreaded(vector<T> &array, int numThreads, Instrumentation instrumentation, SegmentKernel segmentKernel, FastPath fastPath, const Less &less)
+{
+  SortMetrics metrics;
+  bool verbose = instrumentation == Instrumentation::Trace;
+  bool useSimd = segmentKernel == SegmentKernel::Simd && SimdSegmentKernel<T, Less>::supported;
+
+
+  if (verbose)
+  {
+    cout << "\n=== ДЕТАЛЬНИЙ РЕЖИМ: БАГАТОПОТОКОВЕ СОРТУВАННЯ ===\n";
+    cout << getCurrentTimestamp() << " | Початок багатопотокового сортування масиву розміром "
+         << array.size() << " елементів" << endl;
+  }
+
+  int n = array.size();
+  numThreads = resolveThreadCount(numThreads, n, verbose);
+
+  // Start timing
+  SortMeasurement measurement(numThreads, instrumentation, calculateMemoryUsage(array));
+  auto startTime = measurement.startTime();
+
+  if (fastPath == FastPath::Auto && countingSortNarrowRange(array, numThreads, metrics, CountingSortPath<T, Less>()))
+  {
+    // Вузький діапазон значень відсортовано підрахунком, сегменти і злиття не потрібні
+    measurement.finish(metrics);
+
+    metrics.additionalInfo["numThreads"] = to_string(numThreads);
+    metrics.additionalInfo["instrumentation"] = instrumentationName(instrumentation);
+
+    if (verbose)
+    {
+      cout << getCurrentTimestamp() << " | Діапазон значень [" << metrics.additionalInfo["valueMin"] << ", "
+           << metrics.additionalInfo["valueMax"] << "]: сортування підрахунком на " << numThreads << " потоках завершено за "
+           << fixed << setprecision(3) << metrics.executionTimeMs << " мс" << endl;
+      cout << "=== КІНЕЦЬ ДЕТАЛЬНОГО РЕЖИМУ ===\n"
+           << endl;
+    }
+    else
+    {
+      cout << "Вузький діапазон значень: сортування підрахунком на " << numThreads << " потоках" << endl;
+    }
+
+    return metrics;
+  }
+
+  EventTracer::begin(TracePoint::Setup);
+
+  // Print information about threads
+  if (verbose)
+  {
+    cout << getCurrentTimestamp() << " | Сортування на " << numThreads << " потоках" << endl;
+  }
+  else
+  {
+    cout << "Виконання сортування на " << numThreads << " потоках..." << endl;
+  }
+
+  if (numThreads == 1 && !verbose)
+  {
+    cout << "Використовується один потік. Багатопотокові переваги не будуть помітні." << endl;
+  }
+
+  // Масив ділиться на більше сегментів, ніж потоків, щоб вільні потоки могли забрати роботу в зайнятих
+  int numSegments = numThreads > 1 ? numThreads * TASKS_PER_THREAD : 1;
+  int segmentSize = n / numSegments;
+  if (verbose)
+  {
+    cout << getCurrentTimestamp() << " | " << numSegments << " сегментів розміром ~" << segmentSize << " елементів" << endl;
+  }
+  else
+  {
+    cout << "Розмір сегменту: ~" << segmentSize << " елементів (" << numSegments << " сегментів)" << endl;
+  }
+
+  ThreadPoolStats poolStatsBefore = ThreadPool::instance().getStats();
+  WorkStealingScheduler scheduler(numThreads);
+
+  vector<long long> segmentComparisons(numSegments, 0);
+  vector<long long> segmentSwaps(numSegments, 0);
+
+  // Межі сегментів: останній сегмент отримує залишок до n
+  vector<int> boundaries(numSegments + 1);
+  for (int i = 0; i < numSegments; i++)
+  {
+    boundaries[i] = i * segmentSize;
+  }
+  boundaries[numSegments] = n;
+
+  // Злиття розбивається на рівні за розміром виходу частини, кожна - окрема задача
+  int numMergeTasks = numSegments > 1 ? numThreads * TASKS_PER_THREAD : 0;
+  vector<T> tempArray(numMergeTasks > 0 ? n : 0);
+  vector<long long> mergeComparisons(numMergeTasks, 0);
+  vector<long long> mergeSwaps(numMergeTasks, 0);
+
+  atomic<int> segmentsLeft(numSegments);
+  auto sortEndTime = startTime;
+
+  // Час сортування і злиття кожного робітника; задачі одного робітника виконуються послідовно
+  vector<double> threadSortMs(numThreads, 0);
+  vector<double> threadMergeMs(numThreads, 0);
+
+  auto mergeTask = [&](int taskId, WorkStealingScheduler &sched)
+  {
+    TraceScope trace(TracePoint::Merge, taskId);
+    auto taskStart = chrono::high_resolution_clock::now();
+    int outStart = static_cast<int>(static_cast<long long>(taskId) * n / numMergeTasks);
+    int outEnd = static_cast<int>(static_cast<long long>(taskId + 1) * n / numMergeTasks);
+
+    vector<int> from = segmentSplitsForRank(array, boundaries, outStart, less);
+    vector<int> to = taskId + 1 == numMergeTasks ? vector<int>(boundaries.begin() + 1, boundaries.end())
+                                                 : segmentSplitsForRank(array, boundaries, outEnd, less);
+
+    mergeSegmentSlice(array, from, to, tempArray, outStart, mergeComparisons[taskId], mergeSwaps[taskId], less);
+    threadMergeMs[sched.currentWorker()] += chrono::duration<double, milli>(chrono::high_resolution_clock::now() - taskStart).count();
+  };
+
+  // Create segment tasks
+  if (verbose)
+  {
+    cout << getCurrentTimestamp() << " | Створення " << numSegments << " задач сортування сегментів для "
+         << numThreads << " робітників" << endl;
+  }
+
+  for (int i = 0; i < numSegments; i++)
+  {
+    int startIdx = boundaries[i];
+    int endIdx = boundaries[i + 1];
+
+    scheduler.spawn(
+        [&, startIdx, endIdx, i](WorkStealingScheduler &sched)
+        {
+          TraceScope trace(TracePoint::SegmentSort, i);
+          auto taskStart = chrono::high_resolution_clock::now();
+          if (useSimd)
+          {
+            // Векторне ядро сортує сегмент без підрахунку окремих порівнянь
+            SimdSegmentKernel<T, Less>::sort(array.data() + startIdx, endIdx - startIdx);
+          }
+          else
+          {
+            // Run bubble sort on a segment
+            bubbleSortRange(array, startIdx, endIdx, segmentComparisons[i], segmentSwaps[i], instrumentation, less, sched.currentWorker());
+          }
+          threadSortMs[sched.currentWorker()] += chrono::duration<double, milli>(chrono::high_resolution_clock::now() - taskStart).count();
+
+          // Останній відсортований сегмент запускає задачі злиття
+          if (segmentsLeft.fetch_sub(1, memory_order_acq_rel) == 1)
+          {
+            sortEndTime = chrono::high_resolution_clock::now();
+            for (int task = 0; task < numMergeTasks; task++)
+            {
+              sched.spawn([&mergeTask, task](WorkStealingScheduler &s)
+                          { mergeTask(task, s); });
+            }
+          }
+        });
+  }
+
+  EventTracer::end(TracePoint::Setup);
+  auto runStartTime = chrono::high_resolution_clock::now();
+  scheduler.run();
+  auto runEndTime = chrono::high_resolution_clock::now();
+
+  if (numMergeTasks > 0)
+  {
+    array.swap(tempArray);
+  }
+
+  // Sum up comparisons and swaps from all tasks
+  for (int i = 0; i < numSegments; i++)
+  {
+    metrics.comparisons += segmentComparisons[i];
+    metrics.swaps += segmentSwaps[i];
+
+    if (verbose)
+    {
+      cout << getCurrentTimestamp() << " | Метрики сегмента #" << i
+           << ": " << segmentComparisons[i] << " порівнянь, "
+           << segmentSwaps[i] << " обмінів" << endl;
+    }
+  }
+
+  for (int i = 0; i < numMergeTasks; i++)
+  {
+    metrics.comparisons += mergeComparisons[i];
+    metrics.swaps += mergeSwaps[i];
+  }
+
+  WorkStealingStats schedulerStats = scheduler.getStats();
+  if (verbose)
+  {
+    for (int w = 0; w < numThreads; w++)
+    {
+      cout << getCurrentTimestamp() << " | Робітник #" << w << ": " << schedulerStats.workerTasks[w]
+           << " задач, " << fixed << setprecision(3) << schedulerStats.workerBusyMs[w] << " мс роботи" << endl;
+    }
+  }
+
+  // End timing
+  auto endTime = measurement.finish(metrics);
+
+  // Also return the number of threads used
+  metrics.additionalInfo["numThreads"] = to_string(numThreads);
+  metrics.additionalInfo["instrumentation"] = instrumentationName(instrumentation);
+  metrics.additionalInfo["segmentKernel"] = useSimd ? "simd-" + SimdSort::isaName(SimdSort::detectIsa()) : "bubble";
+  metrics.additionalInfo["sortPath"] = "segment-merge";
+  if (useSimd)
+  {
+    // Векторне ядро не рахує порівнянь і обмінів, лічильники охоплюють лише злиття
+    metrics.additionalInfo["counterScope"] = "merge";
+  }
+  recordPoolStats(metrics, poolStatsBefore);
+
+  // Статистика планувальника: крадіжки задач
+  metrics.additionalInfo["steals"] = to_string(schedulerStats.steals);
+
+  recordParallelProfile(metrics, chrono::duration<double, milli>(runStartTime - startTime).count(),
+                        chrono::duration<double, milli>(sortEndTime - runStartTime).count(),
+                        chrono::duration<double, milli>(endTime - runEndTime).count(),
+                        schedulerStats, threadSortMs, threadMergeMs);
+
+  if (verbose)
+  {
+    cout << getCurrentTimestamp() << " | Сортування завершено за "
+         << fixed << setprecision(3) << metrics.executionTimeMs << " мс" << endl;
+    cout << "=== КІНЕЦЬ ДЕТАЛЬНОГО РЕЖИМУ ===\n"
+         << endl;
+  }
+
+  return metrics;
+}
+
+
+template <typename T, typename Less>
+SortMetrics ArrayOperations::oddEvenSortMultithreaded(vector<T> &array, int numThreads, Instrumentation instrumentation, const Less &less)
+{
+  SortMetrics metrics;
+  bool verbose = instrumentation == Instrumentation::Trace;
+
+
+  if (verbose)
+  {
+    cout << "\n=== ДЕТАЛЬНИЙ РЕЖИМ: ПАРНО-НЕПАРНЕ СОРТУВАННЯ ===\n";
+    cout << getCurrentTimestamp() << " | Початок парно-непарного сортування масиву розміром "
+         << array.size() << " елементів" << endl;
+  }
+
+  int n = array.size();
+  numThreads = resolveThreadCount(numThreads, n, verbose);
+
+  // Start timing
+  SortMeasurement measurement(numThreads, instrumentation, calculateMemoryUsage(array));
+
+  if (verbose)
+  {
+    cout << getCurrentTimestamp() << " | Сортування на " << numThreads << " потоках" << endl;
+  }
+  else
+  {
+    cout << "Виконання парно-непарного сортування на " << numThreads << " потоках..." << endl;
+  }
+
+  // Пари (i, i + 1) для i в [0, n - 1) діляться між потоками на суцільні діапазони.
+  // В межах однієї фази пари не перетинаються, тому синхронізація потрібна лише між фазами.
+  int numPairs = max(0, n - 1);
+
+  SpinBarrier barrier(numThreads);
+  // Прапорці обмінів за раунд; три слоти дозволяють скидати наступний без додаткового бар'єру
+  atomic<bool> roundSwapped[3];
+  for (auto &flag : roundSwapped)
+  {
+    flag.store(false, memory_order_relaxed);
+  }
+
+  ThreadPoolStats poolStatsBefore = ThreadPool::instance().getStats();
+  vector<long long> threadComparisons(numThreads, 0);
+  vector<long long> threadSwaps(numThreads, 0);
+  long long totalRounds = 0;
+
+  // Раунди потоку з ядром, спеціалізованим під політику інструментування
+  auto sortPairs = [&](int threadId, auto &policy)
+  {
+    int lo = static_cast<int>(static_cast<long long>(threadId) * numPairs / numThreads);
+    int hi = static_cast<int>(static_cast<long long>(threadId + 1) * numPairs / numThreads);
+
+    if (verbose)
+    {
+      lock_guard<mutex> lock(consoleMutex);
+      cout << getCurrentTimestamp() << " | Потік " << threadId << " | Пари [" << lo << " - " << hi << ")" << endl;
+    }
+
+    long long round = 0;
+    while (true)
+    {
+      if (threadId == 0)
+      {
+        roundSwapped[(round + 1) % 3].store(false, memory_order_relaxed);
+      }
+
+      // Фаза 0 порівнює пари з парним i, фаза 1 - з непарним
+      for (int phase = 0; phase < 2; phase++)
+      {
+        if (oddEvenPhaseKernel(array.data(), lo, hi, phase, less, policy))
+        {
+          roundSwapped[round % 3].store(true, memory_order_relaxed);
+        }
+        barrier.arriveAndWait();
+      }
+
+      // Раунд без жодного обміну означає, що всі сусідні пари впорядковані
+      bool anySwapped = roundSwapped[round % 3].load(memory_order_relaxed);
+      round++;
+      policy.progress(static_cast<int>(round), 0);
+
+      if (!anySwapped)
+      {
+        break;
+      }
+    }
+
+    threadComparisons[threadId] = policy.getComparisons();
+    threadSwaps[threadId] = policy.getSwaps();
+    if (threadId == 0)
+    {
+      totalRounds = round;
+    }
+
+    if (verbose)
+    {
+      lock_guard<mutex> lock(consoleMutex);
+      cout << getCurrentTimestamp() << " | Потік " << threadId << " | Завершено: "
+           << threadComparisons[threadId] << " порівнянь, " << threadSwaps[threadId] << " обмінів" << endl;
+    }
+  };
+
+  auto worker = [&](int threadId)
+  {
+    switch (instrumentation)
+    {
+    case Instrumentation::None:
+    {
+      NoInstrumentation policy;
+      sortPairs(threadId, policy);
+      break;
+    }
+    case Instrumentation::Counters:
+    {
+      CountingInstrumentation policy;
+      sortPairs(threadId, policy);
+      break;
+    }
+    case Instrumentation::Trace:
+    {
+      TracingInstrumentation policy("Потік " + to_string(threadId) + " | ");
+      sortPairs(threadId, policy);
+      break;
+    }
+    case Instrumentation::Timeline:
+    {
+      TimelineInstrumentation policy;
+      sortPairs(threadId, policy);
+      break;
+    }
+    }
+  };
+
+  ThreadPool::instance().runParallel(numThreads, worker);
+
+  for (int i = 0; i < numThreads; i++)
+  {
+    metrics.comparisons += threadComparisons[i];
+    metrics.swaps += threadSwaps[i];
+  }
+
+  // End timing
+  measurement.finish(metrics);
+
+  metrics.additionalInfo["numThreads"] = to_string(numThreads);
+  metrics.additionalInfo["instrumentation"] = instrumentationName(instrumentation);
+  metrics.additionalInfo["rounds"] = to_string(totalRounds);
+  recordPoolStats(metrics, poolStatsBefore);
+
+  if (verbose)
+  {
+    cout << getCurrentTimestamp() << " | Сортування завершено за " << totalRounds << " раундів, "
+         << fixed << setprecision(3) << metrics.executionTimeMs << " мс" << endl;
+    cout << "=== КІНЕЦЬ ДЕТАЛЬНОГО РЕЖИМУ ===\n"
+         << endl;
+  }
+
+  return metrics;
+}
+
+
+template <typename T>
+SortMetrics ArrayOperations::radixSort(vector<T> &array, int numThreads, Instrumentation instrumentation)
+{
+  static_assert(is_integral<T>::value && is_signed<T>::value, "radix sort handles signed integers");
+  typedef typename make_unsigned<T>::type Key;
+
+  const int RADIX = 1 << RADIX_BITS;
+  const int NUM_DIGITS = sizeof(T) * 8 / RADIX_BITS;
+  // Інвертований знаковий біт робить беззнаковий порядок ключів таким самим, як знаковий порядок чисел
+  const Key SIGN_BIT = Key(1) << (sizeof(T) * 8 - 1);
+
+  SortMetrics metrics;
+  bool verbose = instrumentation == Instrumentation::Trace;
+
+
+  if (verbose)
+  {
+    cout << "\n=== ДЕТАЛЬНИЙ РЕЖИМ: ПОРОЗРЯДНЕ СОРТУВАННЯ ===\n";
+    cout << getCurrentTimestamp() << " | Початок порозрядного сортування масиву розміром "
+         << array.size() << " елементів" << endl;
+  }
+
+  int n = array.size();
+  numThreads = resolveThreadCount(numThreads, n, verbose);
+
+  // Start timing
+  SortMeasurement measurement(numThreads, instrumentation, calculateMemoryUsage(array));
+
+  if (verbose)
+  {
+    cout << getCurrentTimestamp() << " | Сортування на " << numThreads << " потоках, " << NUM_DIGITS
+         << " цифр по " << RADIX_BITS << " біт" << endl;
+  }
+  else
+  {
+    cout << "Виконання порозрядного сортування на " << numThreads << " потоках..." << endl;
+  }
+
+  // Другий буфер для розкладання; після кожного проходу буфери міняються ролями
+  vector<T> buffer(n);
+
+  // Гістограми потоків: [потік][цифра][значення цифри]
+  vector<size_t> histograms(static_cast<size_t>(numThreads) * NUM_DIGITS * RADIX, 0);
+  // Загальні гістограми цифр, з яких видно проходи з однаковою цифрою в усіх елементів
+  vector<size_t> totals(NUM_DIGITS * RADIX, 0);
+  vector<char> skipDigit(NUM_DIGITS, 0);
+
+  SpinBarrier barrier(numThreads);
+  ThreadPoolStats poolStatsBefore = ThreadPool::instance().getStats();
+  int executedPasses = 0;
+
+  auto digitOf = [&](T value, int digit)
+  {
+    return static_cast<int>(((static_cast<Key>(value) ^ SIGN_BIT) >> (digit * RADIX_BITS)) & (RADIX - 1));
+  };
+
+  auto worker = [&](int threadId)
+  {
+    // Кожен потік обробляє у всіх проходах ту саму частину індексів, тому розкладання стабільне
+    int lo = static_cast<int>(static_cast<long long>(threadId) * n / numThreads);
+    int hi = static_cast<int>(static_cast<long long>(threadId + 1) * n / numThreads);
+    size_t *own = &histograms[static_cast<size_t>(threadId) * NUM_DIGITS * RADIX];
+
+    // Один прохід читання рахує всі цифри одразу
+    {
+      TraceScope trace(TracePoint::Histogram, -1);
+      for (int i = lo; i < hi; i++)
+      {
+        Key key = static_cast<Key>(array[i]) ^ SIGN_BIT;
+        for (int digit = 0; digit < NUM_DIGITS; digit++)
+        {
+          own[digit * RADIX + ((key >> (digit * RADIX_BITS)) & (RADIX - 1))]++;
+        }
+      }
+    }
+    barrier.arriveAndWait();
+
+    // Загальні гістограми не залежать від порядку елементів; кожен потік сумує свої значення цифр
+    int firstValue = static_cast<int>(static_cast<long long>(threadId) * NUM_DIGITS * RADIX / numThreads);
+    int lastValue = static_cast<int>(static_cast<long long>(threadId + 1) * NUM_DIGITS * RADIX / numThreads);
+    for (int slot = firstValue; slot < lastValue; slot++)
+    {
+      size_t total = 0;
+      for (int t = 0; t < numThreads; t++)
+      {
+        total += histograms[static_cast<size_t>(t) * NUM_DIGITS * RADIX + slot];
+      }
+      totals[slot] = total;
+      if (total == static_cast<size_t>(n))
+      {
+        skipDigit[slot / RADIX] = 1; // Усі елементи мають однакову цифру - прохід нічого не змінить
+      }
+    }
+    barrier.arriveAndWait();
+
+    T *from = array.data();
+    T *to = buffer.data();
+    bool countsCurrent = true; // Гістограма потоку ще описує його частину (до першого розкладання)
+    int passes = 0;
+    vector<size_t> offsets(RADIX);
+
+    for (int digit = 0; digit < NUM_DIGITS; digit++)
+    {
+      if (skipDigit[digit])
+        continue;
+
+      size_t *counts = own + digit * RADIX;
+      if (!countsCurrent)
+      {
+        // Після розкладання частина потоку містить інші елементи, цифру треба порахувати заново
+        TraceScope trace(TracePoint::Histogram, digit);
+        fill(counts, counts + RADIX, 0);
+        for (int i = lo; i < hi; i++)
+        {
+          counts[digitOf(from[i], digit)]++;
+        }
+        barrier.arriveAndWait();
+      }
+      countsCurrent = false;
+
+      // Позиція потоку для значення цифри: усі менші значення плюс це значення в попередніх потоках
+      size_t base = 0;
+      for (int value = 0; value < RADIX; value++)
+      {
+        size_t before = 0;
+        for (int t = 0; t < threadId; t++)
+        {
+          before += histograms[(static_cast<size_t>(t) * NUM_DIGITS + digit) * RADIX + value];
+        }
+        offsets[value] = base + before;
+        base += totals[digit * RADIX + value];
+      }
+
+      {
+        TraceScope trace(TracePoint::Scatter, digit);
+        for (int i = lo; i < hi; i++)
+        {
+          T value = from[i];
+          to[offsets[digitOf(value, digit)]++] = value;
+        }
+      }
+      barrier.arriveAndWait();
+
+      if (verbose && threadId == 0)
+      {
+        lock_guard<mutex> lock(consoleMutex);
+        cout << getCurrentTimestamp() << " | Потік 0 | Завершено прохід за цифрою " << digit << endl;
+      }
+
+      swap(from, to);
+      passes++;
+    }
+
+    if (threadId == 0)
+    {
+      executedPasses = passes;
+    }
+  };
+
+  ThreadPool::instance().runParallel(numThreads, worker);
+
+  // Після непарної кількості проходів результат лежить у другому буфері
+  if (executedPasses % 2 == 1)
+  {
+    array.swap(buffer);
+  }
+
+  // End timing
+  measurement.finish(metrics);
+
+  metrics.additionalInfo["numThreads"] = to_string(numThreads);
+  metrics.additionalInfo["instrumentation"] = instrumentationName(instrumentation);
+  metrics.additionalInfo["radixPasses"] = to_string(executedPasses);
+  metrics.additionalInfo["radixSkippedPasses"] = to_string(NUM_DIGITS - executedPasses);
+  metrics.additionalInfo["radixDigitBits"] = to_string(RADIX_BITS);
+  recordPoolStats(metrics, poolStatsBefore);
+
+  if (verbose)
+  {
+    cout << getCurrentTimestamp() << " | Сортування завершено за " << executedPasses << " проходів (пропущено "
+         << NUM_DIGITS - executedPasses << "), " << fixed << setprecision(3) << metrics.executionTimeMs << " мс" << endl;
+    cout << "=== КІНЕЦЬ ДЕТАЛЬНОГО РЕЖИМУ ===\n"
+         << endl;
+  }
+
+  return metrics;
+}
+
+template <typename T>
+ValueRange ArrayOperations::detectValueRange(const vector<T> &array, int numThreads)
+{
+  static_assert(is_integral<T>::value, "value range is detected for integers");
+
+  ValueRange range;
+  int n = array.size();
+  if (n == 0)
+  {
+    return range;
+  }
+
+  // Як і в рушіях сортування: не більше одного потоку на тисячу елементів
+  if (numThreads <= 0)
+  {
+    numThreads = thread::hardware_concurrency();
+  }
+  numThreads = max(1, min(numThreads, n / 1000));
+
+  vector<T> threadMin(numThreads);
+  vector<T> threadMax(numThreads);
+
+  auto findRange = [&](int threadId)
+  {
+    int lo = static_cast<int>(static_cast<long long>(threadId) * n / numThreads);
+    int hi = static_cast<int>(static_cast<long long>(threadId + 1) * n / numThreads);
+
+    // Цикл без залежних переходів векторизується інструкціями min/max
+    T low = array[lo];
+    T high = array[lo];
+    for (int i = lo + 1; i < hi; i++)
+    {
+      low = min(low, array[i]);
+      high = max(high, array[i]);
+    }
+    threadMin[threadId] = low;
+    threadMax[threadId] = high;
+  };
+
+  ThreadPool::instance().runParallel(numThreads, findRange);
+
+  range.empty = false;
+  range.minValue = *min_element(threadMin.begin(), threadMin.end());
+  range.maxValue = *max_element(threadMax.begin(), threadMax.end());
+  return range;
+}
+
+template <typename T>
+bool ArrayOperations::countingSortNarrowRange(vector<T> &, int, SortMetrics &, false_type)
+{
+  return false;
+}
+
+template <typename T>
+bool ArrayOperations::countingSortNarrowRange(vector<T> &array, int numThreads, SortMetrics &metrics, true_type)
+{
+  int n = array.size();
+  ValueRange range = detectValueRange(array, numThreads);
+  if (range.empty)
+  {
+    return false;
+  }
+
+  metrics.additionalInfo["valueMin"] = to_string(range.minValue);
+  metrics.additionalInfo["valueMax"] = to_string(range.maxValue);
+
+  if (!isNarrowRange(range, n))
+  {
+    return false;
+  }
+
+  T minValue = static_cast<T>(range.minValue);
+  int buckets = static_cast<int>(range.span()) + 1;
+
+  // Гістограми потоків: [потік][значення - мінімум]
+  vector<int> histograms(static_cast<size_t>(numThreads) * buckets, 0);
+  // starts[v] - перша позиція значення v у відсортованому масиві, starts[buckets] = n
+  vector<int> starts(buckets + 1, 0);
+  SpinBarrier barrier(numThreads);
+
+  auto countValues = [&](int threadId)
+  {
+    int lo = static_cast<int>(static_cast<long long>(threadId) * n / numThreads);
+    int hi = static_cast<int>(static_cast<long long>(threadId + 1) * n / numThreads);
+    int *own = &histograms[static_cast<size_t>(threadId) * buckets];
+
+    {
+      TraceScope trace(TracePoint::Histogram, -1);
+      for (int i = lo; i < hi; i++)
+      {
+        own[array[i] - minValue]++;
+      }
+    }
+    barrier.arriveAndWait();
+
+    // Злиття гістограм: кожен потік сумує свою частину значень по всіх потоках
+    int firstValue = static_cast<int>(static_cast<long long>(threadId) * buckets / numThreads);
+    int lastValue = static_cast<int>(static_cast<long long>(threadId + 1) * buckets / numThreads);
+    for (int value = firstValue; value < lastValue; value++)
+    {
+      int total = 0;
+      for (int t = 0; t < numThreads; t++)
+      {
+        total += histograms[static_cast<size_t>(t) * buckets + value];
+      }
+      starts[value + 1] = total;
+    }
+  };
+
+  ThreadPool::instance().runParallel(numThreads, countValues);
+
+  int distinctValues = 0;
+  for (int value = 0; value < buckets; value++)
+  {
+    distinctValues += starts[value + 1] > 0;
+    starts[value + 1] += starts[value];
+  }
+
+  // Вихід ділиться між потоками за позиціями, кожен пише свою частину одним послідовним проходом
+  auto writeValues = [&](int threadId)
+  {
+    TraceScope trace(TracePoint::Scatter, -1);
+    int lo = static_cast<int>(static_cast<long long>(threadId) * n / numThreads);
+    int hi = static_cast<int>(static_cast<long long>(threadId + 1) * n / numThreads);
+
+    // Значення, якому належить перша позиція частини
+    int value = static_cast<int>(upper_bound(starts.begin(), starts.end(), lo) - starts.begin()) - 1;
+    for (int i = lo; i < hi; value++)
+    {
+      int runEnd = min(hi, starts[value + 1]);
+      fill(array.begin() + i, array.begin() + runEnd, static_cast<T>(minValue + value));
+      i = runEnd;
+    }
+  };
+
+  ThreadPool::instance().runParallel(numThreads, writeValues);
+
+  metrics.additionalInfo["distinctValues"] = to_string(distinctValues);
+  metrics.additionalInfo["sortPath"] = "counting";
+  return true;
+}
+
+template <typename T>
+void ArrayOperations::printArray(const vector<T> &array, int maxElements)
+{
+  int size = array.size();
+
+  if (size <= maxElements)
+  {
+    // Print full array if it's small enough
+    for (const T &value : array)
+    {
+      cout << value << " ";
+    }
+  }
+  else
+  {
+    // Print truncated array with indicators
+    int halfMax = maxElements / 2;
+
+    // Print first half of the elements
+    for (int i = 0; i < halfMax; i++)
+    {
+      cout << array[i] << " ";
+    }
+
+    // Print ellipsis to indicate truncation
+    cout << "... [" << (size - maxElements) << " елементів пропущено] ... ";
+
+    // Print last half of the elements
+    for (int i = size - halfMax; i < size; i++)
+    {
+      cout << array[i] << " ";
+    }
+  }
+  cout << endl;
+}
+
+template <typename T>
+size_t ArrayOperations::calculateMemoryUsage(const vector<T> &array)
+{
+  // Calculate memory usage (vector size + overhead)
+  return array.size() * sizeof(T) + sizeof(vector<T>);
+}
+
+
+template <typename T, typename Less>
+SortMetrics ArrayOperations::bubbleSort(vector<T> &array, Instrumentation instrumentation, FastPath fastPath, const Less &less)
+{
+  SortMetrics metrics;
+  bool verbose = instrumentation == Instrumentation::Trace;
+
+
+  if (verbose)
+  {
+    cout << "\n=== ДЕТАЛЬНИЙ РЕЖИМ: ПОСЛІДОВНЕ СОРТУВАННЯ ===\n";
+    cout << getCurrentTimestamp() << " | Початок послідовного сортування масиву розміром "
+         << array.size() << " елементів" << endl;
+  }
+
+  // Start timing
+  SortMeasurement measurement(1, instrumentation, calculateMemoryUsage(array));
+
+  int n = array.size();
+  // Вузький діапазон цілих значень сортується підрахунком на одному потоці, як і решта цього рушія
+  bool counted = fastPath == FastPath::Auto && countingSortNarrowRange(array, 1, metrics, CountingSortPath<T, Less>());
+  if (!counted)
+  {
+    switch (instrumentation)
+    {
+    case Instrumentation::None:
+    {
+      NoInstrumentation policy;
+      runBubbleKernel(array, 0, n, metrics.comparisons, metrics.swaps, less, policy);
+      break;
+    }
+    case Instrumentation::Counters:
+    {
+      CountingInstrumentation policy;
+      runBubbleKernel(array, 0, n, metrics.comparisons, metrics.swaps, less, policy);
+      break;
+    }
+    case Instrumentation::Trace:
+    {
+      TracingInstrumentation policy("");
+      runBubbleKernel(array, 0, n, metrics.comparisons, metrics.swaps, less, policy);
+      break;
+    }
+    case Instrumentation::Timeline:
+    {
+      TimelineInstrumentation policy;
+      runBubbleKernel(array, 0, n, metrics.comparisons, metrics.swaps, less, policy);
+      break;
+    }
+    }
+  }
+
+  // End timing
+  measurement.finish(metrics);
+  metrics.additionalInfo["instrumentation"] = instrumentationName(instrumentation);
+  metrics.additionalInfo["sortPath"] = counted ? "counting" : "bubble";
+
+  if (verbose)
+  {
+    cout << getCurrentTimestamp() << " | Сортування завершено за "
+         << fixed << setprecision(3) << metrics.executionTimeMs << " мс" << endl;
+    cout << "=== КІНЕЦЬ ДЕТАЛЬНОГО РЕЖИМУ ===\n"
+         << endl;
+  }
+
+  return metrics;
+}
+
+// Run one adaptive variant with the given policy, returns the number of passes
+template <typename T, typename Less, typename Policy>
+int runAdaptiveKernel(vector<T> &array, BubbleVariant variant, SortMetrics &metrics, const Less &less, Policy &policy)
+{
+  int n = array.size();
+  int passes = 0;
+  switch (variant)
+  {
+  case BubbleVariant::EarlyExit:
+    passes = earlyExitBubbleKernel(array.data(), 0, n, less, policy);
+    break;
+  case BubbleVariant::CocktailShaker:
+    passes = cocktailShakerKernel(array.data(), 0, n, less, policy);
+    break;
+  case BubbleVariant::Comb:
+    passes = combSortKernel(array.data(), 0, n, less, policy);
+    break;
+  }
+
+  metrics.comparisons += policy.getComparisons();
+  metrics.swaps += policy.getSwaps();
+  return passes;
+}
+
+
+template <typename T, typename Less>
+SortMetrics ArrayOperations::adaptiveBubbleSort(vector<T> &array, BubbleVariant variant, Instrumentation instrumentation, const Less &less)
+{
+  SortMetrics metrics;
+  bool verbose = instrumentation == Instrumentation::Trace;
+
+
+  if (verbose)
+  {
+    cout << "\n=== ДЕТАЛЬНИЙ РЕЖИМ: АДАПТИВНЕ СОРТУВАННЯ (" << bubbleVariantName(variant) << ") ===\n";
+    cout << getCurrentTimestamp() << " | Початок сортування масиву розміром "
+         << array.size() << " елементів" << endl;
+  }
+
+  // Start timing
+  SortMeasurement measurement(1, instrumentation, calculateMemoryUsage(array));
+
+  int passes = 0;
+  switch (instrumentation)
+  {
+  case Instrumentation::None:
+  {
+    NoInstrumentation policy;
+    passes = runAdaptiveKernel(array, variant, metrics, less, policy);
+    break;
+  }
+  case Instrumentation::Counters:
+  {
+    CountingInstrumentation policy;
+    passes = runAdaptiveKernel(array, variant, metrics, less, policy);
+    break;
+  }
+  case Instrumentation::Trace:
+  {
+    TracingInstrumentation policy("");
+    passes = runAdaptiveKernel(array, variant, metrics, less, policy);
+    break;
+  }
+  case Instrumentation::Timeline:
+  {
+    TimelineInstrumentation policy;
+    passes = runAdaptiveKernel(array, variant, metrics, less, policy);
+    break;
+  }
+  }
+
+  // End timing
+  measurement.finish(metrics);
+  metrics.additionalInfo["instrumentation"] = instrumentationName(instrumentation);
+  metrics.additionalInfo["variant"] = bubbleVariantName(variant);
+  metrics.additionalInfo["passes"] = to_string(passes);
+
+  if (verbose)
+  {
+    cout << getCurrentTimestamp() << " | Сортування завершено за " << passes << " проходів, "
+         << fixed << setprecision(3) << metrics.executionTimeMs << " мс" << endl;
+    cout << "=== КІНЕЦЬ ДЕТАЛЬНОГО РЕЖИМУ ===\n"
+         << endl;
+  }
+
+  return metrics;
+}
+
+template <typename T, typename Less>
+bool ArrayOperations::isSorted(const vector<T> &array, const Less &less)
+{
+  // Порожній масив або масив з одного елемента вважається відсортованим
+  return findFirstUnsorted(array, less) == array.size();
+}
+
+// Number of i in [start, end) with array[i] < array[i - 1]; start >= 1.
+// Branchless, so the loop vectorizes for numbers in natural order.
+template <typename T, typename Less>
+inline size_t countDescents(const T *data, size_t start, size_t end, const Less &less)
+{
+  size_t descents = 0;
+  for (size_t i = start; i < end; i++)
+  {
+    descents += less(data[i], data[i - 1]);
+  }
+  return descents;
+}
+
+// First i in [start, end) with array[i] < array[i - 1], or end
+template <typename T, typename Less>
+inline size_t firstDescent(const T *data, size_t start, size_t end, const Less &less)
+{
+  for (size_t i = start; i < end; i++)
+  {
+    if (less(data[i], data[i - 1]))
+      return i;
+  }
+  return end;
+}
+
+template <typename T, typename Less>
+size_t ArrayOperations::findFirstUnsorted(const vector<T> &array, const Less &less, int numThreads)
+{
+  size_t n = array.size();
+  if (n < 2)
+  {
+    return n;
+  }
+
+  numThreads = scanThreadCount(n, numThreads);
+  const T *data = array.data();
+  // Найменший знайдений індекс порушення; потоки з частинами правіше від нього зупиняються
+  atomic<size_t> firstFound(n);
+
+  auto scanPart = [&](int threadId)
+  {
+    // Потік перевіряє пари (i - 1, i) для i зі своєї частини
+    size_t lo = max<size_t>(1, n * threadId / numThreads);
+    size_t hi = n * (threadId + 1) / numThreads;
+
+    for (size_t block = lo; block < hi; block += SCAN_BLOCK)
+    {
+      if (firstFound.load(memory_order_relaxed) < block)
+        return;
+
+      size_t blockEnd = min<size_t>(hi, block + SCAN_BLOCK);
+      if (countDescents(data, block, blockEnd, less) == 0)
+        continue;
+
+      size_t index = firstDescent(data, block, blockEnd, less);
+      size_t current = firstFound.load(memory_order_relaxed);
+      while (index < current && !firstFound.compare_exchange_weak(current, index, memory_order_relaxed))
+      {
+      }
+      return;
+    }
+  };
+
+  if (numThreads == 1)
+  {
+    scanPart(0);
+  }
+  else
+  {
+    ThreadPool::instance().runParallel(numThreads, scanPart);
+  }
+
+  return firstFound.load();
+}
+
+// Bits of a value for the distinct-count sketch; -0.0 and 0.0 are the same value
+template <typename T>
+inline typename enable_if<is_integral<T>::value, uint64_t>::type scanKey(T value)
+{
+  return static_cast<uint64_t>(value);
+}
+
+template <typename T>
+inline typename enable_if<is_floating_point<T>::value, uint64_t>::type scanKey(T value)
+{
+  uint64_t bits = 0;
+  if (value != 0)
+  {
+    memcpy(&bits, &value, sizeof(T));
+  }
+  return bits;
+}
+
+template <typename T>
+ArrayStatistics<T> ArrayOperations::scanArray(const vector<T> &array, int numThreads)
+{
+  typedef typename ArrayStatistics<T>::Sum Sum;
+  NaturalOrder<T> less;
+
+  auto startTime = chrono::high_resolution_clock::now();
+  ArrayStatistics<T> stats;
+  size_t n = array.size();
+  stats.size = n;
+  stats.firstUnsortedIndex = n;
+  if (n == 0)
+  {
+    return stats;
+  }
+
+  numThreads = scanThreadCount(n, numThreads);
+  const T *data = array.data();
+
+  // Частинні результати потоків, зливаються після сканування
+  vector<size_t> threadDescents(numThreads, 0);
+  vector<size_t> threadFirst(numThreads, n);
+  vector<T> threadMin(numThreads);
+  vector<T> threadMax(numThreads);
+  vector<Sum> threadSum(numThreads, Sum());
+  vector<HyperLogLog> sketches(numThreads);
+
+  auto scanPart = [&](int threadId)
+  {
+    size_t lo = n * threadId / numThreads;
+    size_t hi = n * (threadId + 1) / numThreads;
+    size_t descents = 0;
+    size_t first = n;
+    T low = data[lo];
+    T high = data[lo];
+    Sum sum = Sum();
+    HyperLogLog &sketch = sketches[threadId];
+
+    // Кожен блок проходиться кількома короткими циклами: поки блок у L1, окремі цикли векторизуються краще за один спільний
+    for (size_t block = lo; block < hi; block += SCAN_BLOCK)
+    {
+      size_t blockEnd = min<size_t>(hi, block + SCAN_BLOCK);
+
+      size_t pairsStart = max<size_t>(1, block);
+      size_t blockDescents = countDescents(data, pairsStart, blockEnd, less);
+      if (blockDescents > 0 && first == n)
+      {
+        first = firstDescent(data, pairsStart, blockEnd, less);
+      }
+      descents += blockDescents;
+
+      for (size_t i = block; i < blockEnd; i++)
+      {
+        T value = data[i];
+        low = less(value, low) ? value : low;
+        high = less(high, value) ? value : high;
+        sum += value;
+      }
+
+      for (size_t i = block; i < blockEnd; i++)
+      {
+        sketch.add(HyperLogLog::hash(scanKey(data[i])));
+      }
+    }
+
+    threadDescents[threadId] = descents;
+    threadFirst[threadId] = first;
+    threadMin[threadId] = low;
+    threadMax[threadId] = high;
+    threadSum[threadId] = sum;
+  };
+
+  if (numThreads == 1)
+  {
+    scanPart(0);
+  }
+  else
+  {
+    ThreadPool::instance().runParallel(numThreads, scanPart);
+  }
+
+  size_t descents = 0;
+  stats.minValue = threadMin[0];
+  stats.maxValue = threadMax[0];
+  for (int t = 0; t < numThreads; t++)
+  {
+    descents += threadDescents[t];
+    stats.firstUnsortedIndex = min(stats.firstUnsortedIndex, threadFirst[t]);
+    stats.minValue = less(threadMin[t], stats.minValue) ? threadMin[t] : stats.minValue;
+    stats.maxValue = less(stats.maxValue, threadMax[t]) ? threadMax[t] : stats.maxValue;
+    stats.sum += threadSum[t];
+    if (t > 0)
+    {
+      sketches[0].merge(sketches[t]);
+    }
+  }
+
+  stats.sorted = descents == 0;
+  stats.runCount = descents + 1;
+  // Оцінка не може перевищувати кількість елементів
+  stats.distinctEstimate = min(sketches[0].estimate(), static_cast<double>(n));
+  stats.scanMs = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - startTime).count();
+  return stats;
+}
+
+template <typename T>
+void ArrayOperations::recordStatistics(SortMetrics &metrics, const ArrayStatistics<T> &stats)
+{
+  ostringstream scanTime;
+  scanTime << fixed << setprecision(3) << stats.scanMs;
+
+  metrics.additionalInfo["outputSorted"] = stats.sorted ? "true" : "false";
+  if (!stats.sorted)
+  {
+    metrics.additionalInfo["outputFirstUnsorted"] = to_string(stats.firstUnsortedIndex);
+  }
+  metrics.additionalInfo["outputRuns"] = to_string(stats.runCount);
+  metrics.additionalInfo["outputDistinct"] = to_string(static_cast<long long>(stats.distinctEstimate + 0.5));
+  metrics.additionalInfo["outputScanMs"] = scanTime.str();
+}
+
+#endif // ARRAY_OPERATIONS_IMPL_H
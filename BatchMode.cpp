@@ -0,0 +1,609 @@
+#include "BatchMode.h"
+#include "ExternalSort.h"
+#include "EventTracer.h"
+#include "CommandLine.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <set>
+#include <stdexcept>
+#include <algorithm>
+
+namespace
+{
+  string jsonEscape(const string &value)
+  {
+    string result;
+    for (char c : value)
+    {
+      switch (c)
+      {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      case '\t':
+        result += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char buffer[8];
+          snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+          result += buffer;
+        }
+        else
+        {
+          result += c;
+        }
+      }
+    }
+    return result;
+  }
+
+  string csvEscape(const string &value)
+  {
+    if (value.find_first_of(",\"\n\r") == string::npos)
+    {
+      return value;
+    }
+
+    string result = "\"";
+    for (char c : value)
+    {
+      result += c == '"' ? string("\"\"") : string(1, c);
+    }
+    return result + "\"";
+  }
+
+  // Сумарні та потокові апаратні лічильники; подія, що не рахувалась, - null
+  void writeHardwareCountsJson(ostream &out, const HardwareCounts &counts)
+  {
+    out << "{";
+    if (counts.threadId != 0)
+    {
+      out << "\"threadId\": " << counts.threadId << ", ";
+    }
+    for (int e = 0; e < HardwareCounts::NUM_EVENTS; e++)
+    {
+      out << "\"" << HardwareCounters::eventName(static_cast<HardwareEvent>(e)) << "\": ";
+      if (counts.values[e] < 0)
+        out << "null";
+      else
+        out << counts.values[e];
+      out << ", ";
+    }
+    out << "\"ipc\": ";
+    if (counts.ipc() < 0)
+      out << "null";
+    else
+      out << fixed << setprecision(6) << counts.ipc();
+    out << "}";
+  }
+
+  void writeHardwareCountersJson(ostream &out, const HardwareCounterReport &report)
+  {
+    if (!report.available)
+    {
+      out << "{\"available\": false, \"reason\": \"" << jsonEscape(report.unavailableReason) << "\"}";
+      return;
+    }
+
+    out << "{\"available\": true, \"total\": ";
+    writeHardwareCountsJson(out, report.total);
+    out << ", \"perThread\": [";
+    for (size_t t = 0; t < report.perThread.size(); t++)
+    {
+      out << (t > 0 ? ", " : "");
+      writeHardwareCountsJson(out, report.perThread[t]);
+    }
+    out << "]}";
+  }
+
+  void writeNumberListJson(ostream &out, const vector<double> &values)
+  {
+    out << "[";
+    for (size_t i = 0; i < values.size(); i++)
+    {
+      out << (i > 0 ? ", " : "") << values[i];
+    }
+    out << "]";
+  }
+
+  // Фази паралельного сортування; null для алгоритмів без планувальника
+  void writeParallelProfileJson(ostream &out, const ParallelProfile &profile)
+  {
+    if (!profile.recorded)
+    {
+      out << "null";
+      return;
+    }
+
+    out << fixed << setprecision(6)
+        << "{\"setupMs\": " << profile.setupMs
+        << ", \"spawnMs\": " << profile.spawnMs
+        << ", \"sortMs\": " << profile.sortMs
+        << ", \"mergeMs\": " << profile.mergeMs
+        << ", \"joinMs\": " << profile.joinMs
+        << ", \"finalizeMs\": " << profile.finalizeMs
+        << ", \"threadSortMs\": ";
+    writeNumberListJson(out, profile.threadSortMs);
+    out << ", \"threadMergeMs\": ";
+    writeNumberListJson(out, profile.threadMergeMs);
+    out << ", \"threadTaskCpuMs\": ";
+    writeNumberListJson(out, profile.threadTaskCpuMs);
+    out << ", \"threadCpuMs\": ";
+    writeNumberListJson(out, profile.threadCpuMs);
+    out << ", \"loadImbalance\": " << profile.loadImbalance
+        << ", \"parallelEfficiency\": " << profile.parallelEfficiency
+        << ", \"serialFraction\": ";
+    if (profile.threadSortMs.size() > 1)
+      out << profile.serialFraction;
+    else
+      out << "null";
+    out << "}";
+  }
+
+  // Файл трасування одного запуску: без змін, якщо запуск один, інакше з назвою алгоритму і номером повтору
+  string traceFileName(const BatchOptions &options, const string &algorithm, int repetition)
+  {
+    if (options.algorithms.size() == 1 && options.repetitions == 1)
+      return options.traceFile;
+
+    size_t dot = options.traceFile.find_last_of('.');
+    size_t slash = options.traceFile.find_last_of('/');
+    if (dot == string::npos || (slash != string::npos && dot < slash))
+      dot = options.traceFile.size();
+
+    return options.traceFile.substr(0, dot) + "-" + algorithm + "-" + to_string(repetition) + options.traceFile.substr(dot);
+  }
+
+  // Перевірка впорядкованості файлу без завантаження його в пам'ять
+  bool isFileSorted(const string &filename)
+  {
+    ArrayFileReader reader(filename);
+    vector<int> chunk;
+    bool first = true;
+    int previous = 0;
+
+    while (reader.read(chunk, 1 << 20) > 0)
+    {
+      if (!first && chunk[0] < previous)
+        return false;
+      if (!ArrayOperations::isSorted(chunk))
+        return false;
+      previous = chunk.back();
+      first = false;
+    }
+    return true;
+  }
+}
+
+void BatchMode::printUsage(ostream &out)
+{
+  out << "Використання: BubbleSortApp [параметри]\n"
+      << "Без параметрів запускається інтерактивне меню.\n\n"
+      << "Вхідні дані (один з варіантів):\n"
+      << "  --input ФАЙЛ              масив із файлу (текстовий або бінарний)\n"
+      << "  --generate РОЗПОДІЛ       згенерувати масив; потрібен --size\n"
+      << "  --size N                  розмір згенерованого масиву\n"
+      << "  --min A, --max B          діапазон значень (типово 0..100)\n"
+      << "  --seed S                  seed генератора (типово випадковий)\n"
+      << "  --swaps K                 обміни для nearly-sorted\n"
+      << "  --period P                довжина зубця для sawtooth\n"
+      << "  --unique U                кількість значень для few-unique\n"
+      << "  --zipf S                  показник для zipf\n\n"
+      << "Сортування:\n"
+      << "  --algorithm A[,B...]      алгоритми (типово multithreaded)\n"
+      << "  --threads N               кількість потоків (0 - автоматично)\n"
+      << "  --instrumentation M       none, counters, trace або timeline (типово counters)\n"
+      << "  --trace ФАЙЛ              записати часову шкалу потоків у Chrome trace JSON (вмикає timeline)\n"
+      << "  --repetitions R           повтори кожного алгоритму (типово 1)\n"
+      << "  --memory-mb M             бюджет пам'яті для external (типово 256)\n"
+      << "  --fast-path M             auto або off: сортування підрахунком вузького діапазону\n"
+      << "                            цілих у bubble і multithreaded (типово auto)\n\n"
+      << "Вивід:\n"
+      << "  --output ФАЙЛ             зберегти відсортований масив (обов'язково для external)\n"
+      << "  --output-format F         text або binary (типово text)\n"
+      << "  --results ФАЙЛ            файл результатів (типово стандартний вивід)\n"
+      << "  --format F                json або csv (типово json)\n"
+      << "  --verbose                 показувати повідомлення рушіїв сортування\n"
+      << "  --help                    ця довідка\n\n";
+
+  out << "Алгоритми:\n";
+  for (const auto &algorithm : SortRegistry::all())
+  {
+    out << "  " << left << setw(24) << algorithm.name << algorithm.description << "\n";
+  }
+  out << "  " << left << setw(24) << "external" << "зовнішнє сортування файлу --input у --output\n\n";
+
+  out << "Розподіли:";
+  for (int i = 0; i < ArrayGenerator::NUM_DISTRIBUTIONS; i++)
+  {
+    out << " " << ArrayGenerator::distributionName(static_cast<Distribution>(i));
+  }
+  out << "\n";
+}
+
+BatchOptions BatchMode::parseArguments(int argc, char *argv[])
+{
+  BatchOptions options;
+
+  for (int i = 1; i < argc; i++)
+  {
+    string option = argv[i];
+    if (option == "--help" || option == "--verbose")
+    {
+      if (option == "--verbose")
+        options.verbose = true;
+      continue;
+    }
+
+    string value = CommandLine::readOption(argc, argv, i, option);
+
+    if (option == "--input")
+      options.inputFile = value;
+    else if (option == "--generate")
+    {
+      options.distribution = ArrayGenerator::distributionFromName(value);
+      options.generate = true;
+    }
+    else if (option == "--size")
+      options.size = CommandLine::parseInt(option, value, 1);
+    else if (option == "--min")
+      options.params.minValue = CommandLine::parseInt(option, value, INT32_MIN);
+    else if (option == "--max")
+      options.params.maxValue = CommandLine::parseInt(option, value, INT32_MIN);
+    else if (option == "--seed")
+    {
+      options.seed = CommandLine::parseSeed(option, value);
+      options.seedGiven = true;
+    }
+    else if (option == "--swaps")
+      options.params.swaps = CommandLine::parseInt(option, value, 0);
+    else if (option == "--period")
+      options.params.period = CommandLine::parseInt(option, value, 1);
+    else if (option == "--unique")
+      options.params.uniqueValues = CommandLine::parseInt(option, value, 1);
+    else if (option == "--zipf")
+    {
+      char *end = nullptr;
+      options.params.zipfExponent = strtod(value.c_str(), &end);
+      if (end == value.c_str() || *end != '\0')
+        throw runtime_error("Некоректне значення параметра --zipf: " + value);
+    }
+    else if (option == "--algorithm")
+    {
+      for (const string &name : CommandLine::splitList(value))
+      {
+        if (name != "external")
+          SortRegistry::find(name); // Перевірка назви до початку роботи
+        options.algorithms.push_back(name);
+      }
+    }
+    else if (option == "--threads")
+      options.sortOptions.numThreads = CommandLine::parseInt(option, value, 0);
+    else if (option == "--instrumentation")
+      options.sortOptions.instrumentation = CommandLine::parseInstrumentation(value);
+    else if (option == "--fast-path")
+      options.sortOptions.fastPath = CommandLine::parseFastPath(value);
+    else if (option == "--repetitions")
+      options.repetitions = CommandLine::parseInt(option, value, 1);
+    else if (option == "--trace")
+      options.traceFile = value;
+    else if (option == "--memory-mb")
+      options.memoryBudgetMb = CommandLine::parseInt(option, value, 1);
+    else if (option == "--output")
+      options.outputFile = value;
+    else if (option == "--output-format")
+      options.outputFormat = CommandLine::parseFileFormat(value);
+    else if (option == "--results")
+      options.resultsFile = value;
+    else if (option == "--format")
+    {
+      if (value != "json" && value != "csv")
+        throw runtime_error("Невідомий формат результатів: " + value + " (доступні: json, csv)");
+      options.resultsFormat = value;
+    }
+    else
+      throw runtime_error("Невідомий параметр: " + option);
+  }
+
+  if (options.algorithms.empty())
+  {
+    options.algorithms.push_back("multithreaded");
+  }
+
+  bool external = find(options.algorithms.begin(), options.algorithms.end(), "external") != options.algorithms.end();
+  bool inMemory = !external || options.algorithms.size() > 1;
+
+  if (inMemory && options.generate == !options.inputFile.empty())
+  {
+    throw runtime_error("Потрібно вказати рівно одне джерело даних: --input або --generate");
+  }
+  if (!inMemory && options.generate)
+  {
+    throw runtime_error("Алгоритм external сортує лише файл --input");
+  }
+  if (options.generate && options.size <= 0)
+  {
+    throw runtime_error("Для --generate потрібно вказати --size");
+  }
+  if (options.params.minValue > options.params.maxValue)
+  {
+    throw runtime_error("Мінімальне значення не може бути більшим за максимальне");
+  }
+  if (external && (options.inputFile.empty() || options.outputFile.empty()))
+  {
+    throw runtime_error("Алгоритм external потребує --input і --output");
+  }
+
+  if (!options.traceFile.empty())
+  {
+    options.sortOptions.instrumentation = Instrumentation::Timeline;
+  }
+
+  if (!options.seedGiven)
+  {
+    options.seed = ArrayOperations::randomSeed();
+  }
+
+  return options;
+}
+
+void BatchMode::writeJson(ostream &out, const vector<BatchResult> &results)
+{
+  out << "[\n";
+  for (size_t i = 0; i < results.size(); i++)
+  {
+    const BatchResult &result = results[i];
+    const SortMetrics &metrics = result.metrics;
+
+    out << "  {\"algorithm\": \"" << jsonEscape(result.algorithm) << "\""
+        << ", \"repetition\": " << result.repetition
+        << ", \"size\": " << result.size
+        << ", \"sorted\": " << (result.sorted ? "true" : "false")
+        << ", \"comparisons\": " << metrics.comparisons
+        << ", \"swaps\": " << metrics.swaps
+        << ", \"executionTimeMs\": " << fixed << setprecision(6) << metrics.executionTimeMs
+        << ", \"memoryUsageBytes\": " << metrics.memoryUsageBytes
+        << ", \"peakHeapBytes\": " << metrics.memory.peakHeapBytes
+        << ", \"allocations\": " << metrics.memory.allocations
+        << ", \"peakRssBytes\": " << metrics.memory.peakRssBytes
+        << ", \"peakRssDeltaBytes\": " << metrics.memory.peakRssDeltaBytes
+        << ", \"additionalInfo\": {";
+
+    bool first = true;
+    for (const auto &entry : metrics.additionalInfo)
+    {
+      out << (first ? "" : ", ") << "\"" << jsonEscape(entry.first) << "\": \"" << jsonEscape(entry.second) << "\"";
+      first = false;
+    }
+    out << "}, \"hardwareCounters\": ";
+    writeHardwareCountersJson(out, metrics.hardwareCounters);
+    out << ", \"parallel\": ";
+    writeParallelProfileJson(out, metrics.parallel);
+    out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  out << "]\n";
+}
+
+void BatchMode::writeCsv(ostream &out, const vector<BatchResult> &results)
+{
+  // Стовпці additionalInfo - об'єднання ключів усіх запусків
+  set<string> keys;
+  for (const auto &result : results)
+  {
+    for (const auto &entry : result.metrics.additionalInfo)
+    {
+      keys.insert(entry.first);
+    }
+  }
+
+  out << "algorithm,repetition,size,sorted,comparisons,swaps,executionTimeMs,memoryUsageBytes,"
+      << "peakHeapBytes,allocations,peakRssBytes,peakRssDeltaBytes,"
+      << "setupMs,spawnMs,sortMs,mergeMs,joinMs,finalizeMs,loadImbalance,parallelEfficiency,serialFraction";
+  for (int e = 0; e < HardwareCounts::NUM_EVENTS; e++)
+  {
+    out << "," << HardwareCounters::eventName(static_cast<HardwareEvent>(e));
+  }
+  out << ",ipc";
+  for (const string &key : keys)
+  {
+    out << "," << csvEscape(key);
+  }
+  out << "\n";
+
+  for (const auto &result : results)
+  {
+    const SortMetrics &metrics = result.metrics;
+    out << csvEscape(result.algorithm) << "," << result.repetition << "," << result.size << ","
+        << (result.sorted ? "true" : "false") << "," << metrics.comparisons << "," << metrics.swaps << ","
+        << fixed << setprecision(6) << metrics.executionTimeMs << "," << metrics.memoryUsageBytes << ","
+        << metrics.memory.peakHeapBytes << "," << metrics.memory.allocations << ","
+        << metrics.memory.peakRssBytes << "," << metrics.memory.peakRssDeltaBytes;
+
+    // Фази паралельного сортування; порожньо для алгоритмів без планувальника
+    const ParallelProfile &profile = metrics.parallel;
+    if (profile.recorded)
+    {
+      out << "," << profile.setupMs << "," << profile.spawnMs << "," << profile.sortMs << "," << profile.mergeMs
+          << "," << profile.joinMs << "," << profile.finalizeMs << "," << profile.loadImbalance
+          << "," << profile.parallelEfficiency << ",";
+      if (profile.threadSortMs.size() > 1)
+        out << profile.serialFraction;
+    }
+    else
+    {
+      out << ",,,,,,,,,";
+    }
+
+    // Сумарні апаратні лічильники; порожньо, якщо подія не рахувалась
+    const HardwareCounts &hardware = metrics.hardwareCounters.total;
+    for (int e = 0; e < HardwareCounts::NUM_EVENTS; e++)
+    {
+      out << ",";
+      if (hardware.values[e] >= 0)
+        out << hardware.values[e];
+    }
+    out << ",";
+    if (hardware.ipc() >= 0)
+      out << hardware.ipc();
+
+    for (const string &key : keys)
+    {
+      auto it = metrics.additionalInfo.find(key);
+      out << "," << (it != metrics.additionalInfo.end() ? csvEscape(it->second) : "");
+    }
+    out << "\n";
+  }
+}
+
+int BatchMode::run(int argc, char *argv[])
+{
+  for (int i = 1; i < argc; i++)
+  {
+    if (string(argv[i]) == "--help")
+    {
+      printUsage(cout);
+      return 0;
+    }
+  }
+
+  BatchOptions options;
+  try
+  {
+    options = parseArguments(argc, argv);
+  }
+  catch (const exception &e)
+  {
+    cerr << "Помилка: " << e.what() << "\n\n";
+    printUsage(cerr);
+    return 2;
+  }
+
+  NullBuffer nullBuffer;
+  streambuf *console = cout.rdbuf();
+  vector<BatchResult> results;
+  bool allSorted = true;
+
+  try
+  {
+    if (!options.verbose)
+    {
+      cout.rdbuf(&nullBuffer);
+    }
+
+    // Вхідний масив завантажується або генерується один раз для всіх алгоритмів
+    vector<int> source;
+    map<string, string> origin;
+    if (options.generate)
+    {
+      source = ArrayOperations::generateArray(options.size, options.distribution, options.params, options.seed);
+      origin["seed"] = to_string(options.seed);
+      origin["distribution"] = ArrayGenerator::distributionName(options.distribution);
+    }
+    else if (any_of(options.algorithms.begin(), options.algorithms.end(), [](const string &name)
+                    { return name != "external"; }))
+    {
+      source = ArrayOperations::loadArrayFromFile(options.inputFile);
+      origin["input"] = options.inputFile;
+    }
+
+    for (const string &name : options.algorithms)
+    {
+      for (int repetition = 1; repetition <= options.repetitions; repetition++)
+      {
+        cerr << name << ": повтор " << repetition << "/" << options.repetitions << "\n";
+
+        BatchResult result;
+        result.algorithm = name;
+        result.repetition = repetition;
+
+        if (name == "external")
+        {
+          result.metrics = ExternalSort::sortFile(options.inputFile, options.outputFile, options.memoryBudgetMb << 20,
+                                                  options.sortOptions.numThreads, options.outputFormat);
+          result.metrics.additionalInfo["input"] = options.inputFile;
+          result.size = ArrayFileReader(options.outputFile).size();
+          result.sorted = isFileSorted(options.outputFile);
+        }
+        else
+        {
+          vector<int> array = source;
+          result.metrics = SortRegistry::find(name).run(array, options.sortOptions);
+          for (const auto &entry : origin)
+          {
+            result.metrics.additionalInfo[entry.first] = entry.second;
+          }
+          result.size = array.size();
+          ArrayStatistics<int> stats = ArrayOperations::scanArray(array);
+          ArrayOperations::recordStatistics(result.metrics, stats);
+          result.sorted = stats.sorted;
+
+          if (!options.traceFile.empty())
+          {
+            // Алгоритми без підтримки timeline не створюють сесії трасування
+            if (result.metrics.additionalInfo.count("traceEvents"))
+            {
+              string traceFile = traceFileName(options, name, repetition);
+              EventTracer::writeChromeTrace(traceFile);
+              result.metrics.additionalInfo["traceFile"] = traceFile;
+            }
+            else
+            {
+              cerr << name << ": часова шкала не підтримується, трасування не записано\n";
+            }
+          }
+
+          // Відсортований масив останнього повтору зберігається у файл
+          if (!options.outputFile.empty() && repetition == options.repetitions)
+          {
+            ArrayOperations::saveArrayToFile(array, options.outputFile, options.outputFormat);
+          }
+        }
+
+        allSorted = allSorted && result.sorted;
+        results.push_back(result);
+      }
+    }
+
+    cout.rdbuf(console);
+  }
+  catch (const exception &e)
+  {
+    cout.rdbuf(console);
+    cerr << "Помилка: " << e.what() << endl;
+    return 1;
+  }
+
+  ofstream resultsFile;
+  if (!options.resultsFile.empty())
+  {
+    resultsFile.open(options.resultsFile);
+    if (!resultsFile.is_open())
+    {
+      cerr << "Помилка: неможливо відкрити файл для запису: " << options.resultsFile << endl;
+      return 1;
+    }
+  }
+  ostream &out = options.resultsFile.empty() ? cout : resultsFile;
+
+  if (options.resultsFormat == "csv")
+    writeCsv(out, results);
+  else
+    writeJson(out, results);
+
+  if (!allSorted)
+  {
+    cerr << "Помилка: щонайменше один результат не відсортований" << endl;
+    return 3;
+  }
+  return 0;
+}
@@ -0,0 +1,67 @@
+#ifndef BATCH_MODE_H
+#define BATCH_MODE_H
+
+#include <vector>
+#include <string>
+#include "ArrayOperations.h"
+#include "SortRegistry.h"
+
+using namespace std;
+
+// Settings of one non-interactive run, parsed from the command line
+struct BatchOptions
+{
+  string inputFile;                // Вхідний файл
+  bool generate;                   // Генерувати масив замість читання файлу
+  Distribution distribution;       // Форма згенерованого масиву
+  int size;                        // Розмір згенерованого масиву
+  DistributionParams params;       // Параметри генерації
+  uint64_t seed;                   // Seed генерації
+  bool seedGiven;                  // false - seed вибирається випадково
+  vector<string> algorithms;       // Назви алгоритмів (SortRegistry або "external")
+  SortOptions sortOptions;         // Потоки та інструментування
+  int repetitions;                 // Кількість повторів кожного алгоритму
+  string outputFile;               // Файл для відсортованого масиву (необов'язковий)
+  ArrayFileFormat outputFormat;    // Формат відсортованого масиву
+  string resultsFile;              // Файл результатів (порожній - стандартний вивід)
+  string resultsFormat;            // "json" або "csv"
+  size_t memoryBudgetMb;           // Бюджет пам'яті зовнішнього сортування
+  bool verbose;                    // Показувати вивід рушіїв сортування
+  string traceFile;                // Файл Chrome trace (вмикає інструментування timeline)
+
+  BatchOptions()
+      : generate(false), distribution(Distribution::Uniform), size(0), seed(0), seedGiven(false), repetitions(1),
+        outputFormat(ArrayFileFormat::Text), resultsFormat("json"), memoryBudgetMb(256), verbose(false)
+  {
+  }
+};
+
+// Metrics of one sort run in batch mode
+struct BatchResult
+{
+  string algorithm;
+  int repetition;
+  size_t size;
+  bool sorted;
+  SortMetrics metrics;
+};
+
+// Command-line mode for scripts and job schedulers: no prompts, results of
+// every run written as JSON or CSV. main() uses it when arguments are given.
+class BatchMode
+{
+public:
+  // Returns the process exit code: 0 - success, 1 - runtime error,
+  // 2 - invalid arguments, 3 - a result was not sorted
+  static int run(int argc, char *argv[]);
+
+  // Throws runtime_error on invalid arguments
+  static BatchOptions parseArguments(int argc, char *argv[]);
+
+  static void writeJson(ostream &out, const vector<BatchResult> &results);
+  static void writeCsv(ostream &out, const vector<BatchResult> &results);
+
+  static void printUsage(ostream &out);
+};
+
+#endif // BATCH_MODE_H
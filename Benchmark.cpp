@@ -0,0 +1,386 @@
+#include "ArrayOperations.h"
+#include "SortRegistry.h"
+#include "CommandLine.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+#include <thread>
+
+using namespace std;
+
+// Налаштування матриці вимірювань
+struct BenchmarkConfig
+{
+  vector<string> algorithms;
+  vector<int> sizes;
+  vector<Distribution> distributions;
+  vector<int> threadCounts;
+  int warmup;
+  int trials;
+  uint64_t seed;
+  Instrumentation instrumentation;
+  FastPath fastPath;
+  string csvFile;
+
+  BenchmarkConfig() : warmup(1), trials(5), seed(20240601), instrumentation(Instrumentation::None), fastPath(FastPath::Auto), csvFile("benchmark.csv") {}
+};
+
+// Статистика часу однієї клітинки матриці
+struct TrialStats
+{
+  int trials;
+  double minMs;
+  double maxMs;
+  double meanMs;
+  double medianMs;
+  double p95Ms;
+  double stddevMs;
+  double ciLowMs; // 95% довірчий інтервал середнього
+  double ciHighMs;
+};
+
+struct BenchmarkRow
+{
+  string algorithm;
+  string distribution;
+  int size;
+  int threads; // 0 для послідовних алгоритмів
+  TrialStats stats;
+};
+
+// Квантиль t-розподілу Стьюдента для двостороннього 95% інтервалу
+double studentT95(int degreesOfFreedom)
+{
+  static const double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+  if (degreesOfFreedom < 1)
+    return 0;
+  if (degreesOfFreedom <= 30)
+    return table[degreesOfFreedom - 1];
+  return 1.960;
+}
+
+TrialStats computeStats(vector<double> samples)
+{
+  TrialStats stats;
+  int n = samples.size();
+  sort(samples.begin(), samples.end());
+
+  stats.trials = n;
+  stats.minMs = samples.front();
+  stats.maxMs = samples.back();
+  stats.medianMs = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+
+  // p95 за найближчим рангом
+  int rank = static_cast<int>(ceil(0.95 * n));
+  stats.p95Ms = samples[max(0, rank - 1)];
+
+  double sum = 0;
+  for (double sample : samples)
+    sum += sample;
+  stats.meanMs = sum / n;
+
+  double squares = 0;
+  for (double sample : samples)
+    squares += (sample - stats.meanMs) * (sample - stats.meanMs);
+  stats.stddevMs = n > 1 ? sqrt(squares / (n - 1)) : 0;
+
+  double halfWidth = studentT95(n - 1) * stats.stddevMs / sqrt(static_cast<double>(n));
+  stats.ciLowMs = stats.meanMs - halfWidth;
+  stats.ciHighMs = stats.meanMs + halfWidth;
+  return stats;
+}
+
+void printUsage()
+{
+  cout << "Використання: BubbleSortBenchmark [параметри]\n"
+       << "  --algorithms A,B,...   алгоритми (типово всі)\n"
+       << "  --sizes N,M,...        розміри масивів (типово 1000,5000,20000)\n"
+       << "  --distributions D,...  розподіли (типово uniform,sorted,reversed,few-unique)\n"
+       << "  --threads T,...        кількості потоків паралельних алгоритмів (типово 1 і всі ядра)\n"
+       << "  --warmup W             прогрівальні запуски без вимірювання (типово 1)\n"
+       << "  --trials R             виміряні запуски (типово 5)\n"
+       << "  --seed S               seed генерації масивів (типово 20240601)\n"
+       << "  --instrumentation M    none, counters, trace або timeline (типово none)\n"
+       << "  --fast-path M          auto або off: сортування підрахунком вузького діапазону (типово auto)\n"
+       << "  --csv ФАЙЛ             файл CSV з результатами (типово benchmark.csv)\n"
+       << "  --overhead             лише вартість інструментування послідовного сортування\n";
+}
+
+BenchmarkConfig parseArguments(int argc, char *argv[])
+{
+  BenchmarkConfig config;
+
+  for (int i = 1; i < argc; i++)
+  {
+    string option;
+    string value = CommandLine::readOption(argc, argv, i, option);
+
+    if (option == "--algorithms")
+    {
+      for (const string &name : CommandLine::splitList(value))
+        config.algorithms.push_back(SortRegistry::find(name).name);
+    }
+    else if (option == "--sizes")
+    {
+      for (const string &size : CommandLine::splitList(value))
+        config.sizes.push_back(CommandLine::parseInt(option, size, 1));
+    }
+    else if (option == "--distributions")
+    {
+      for (const string &name : CommandLine::splitList(value))
+        config.distributions.push_back(ArrayGenerator::distributionFromName(name));
+    }
+    else if (option == "--threads")
+    {
+      for (const string &threads : CommandLine::splitList(value))
+        config.threadCounts.push_back(CommandLine::parseInt(option, threads, 1));
+    }
+    else if (option == "--warmup")
+      config.warmup = CommandLine::parseInt(option, value, 0);
+    else if (option == "--trials")
+      config.trials = CommandLine::parseInt(option, value, 1);
+    else if (option == "--seed")
+      config.seed = CommandLine::parseSeed(option, value);
+    else if (option == "--instrumentation")
+      config.instrumentation = CommandLine::parseInstrumentation(value);
+    else if (option == "--fast-path")
+      config.fastPath = CommandLine::parseFastPath(value);
+    else if (option == "--csv")
+      config.csvFile = value;
+    else
+      throw runtime_error("Невідомий параметр: " + option);
+  }
+
+  if (config.algorithms.empty())
+  {
+    for (const auto &algorithm : SortRegistry::all())
+      config.algorithms.push_back(algorithm.name);
+  }
+  if (config.sizes.empty())
+    config.sizes = {1000, 5000, 20000};
+  if (config.distributions.empty())
+    config.distributions = {Distribution::Uniform, Distribution::Sorted, Distribution::Reversed, Distribution::FewUnique};
+  if (config.threadCounts.empty())
+  {
+    int cores = max(1u, thread::hardware_concurrency());
+    config.threadCounts = cores > 1 ? vector<int>{1, cores} : vector<int>{1};
+  }
+
+  return config;
+}
+
+// Прогрівальні і виміряні запуски одного алгоритму на копіях масиву
+TrialStats measure(const SortAlgorithm &algorithm, const vector<int> &source, const SortOptions &options, int warmup, int trials)
+{
+  vector<double> samples;
+  for (int run = 0; run < warmup + trials; run++)
+  {
+    vector<int> array = source;
+    SortMetrics metrics = algorithm.run(array, options);
+
+    if (!ArrayOperations::isSorted(array))
+    {
+      throw runtime_error("Алгоритм " + algorithm.name + " повернув невідсортований масив");
+    }
+    if (run >= warmup)
+    {
+      samples.push_back(metrics.executionTimeMs);
+    }
+  }
+  return computeStats(samples);
+}
+
+// Запуск матриці алгоритм x розподіл x розмір x потоки; таблиця в консоль, результати в CSV
+int runMatrix(const BenchmarkConfig &config)
+{
+  cout << "===== БЕНЧМАРК СОРТУВАЛЬНИХ РУШІЇВ =====\n";
+  cout << "Seed масивів: " << config.seed << ", прогрів: " << config.warmup << ", вимірювань: " << config.trials
+       << ", інструментування: " << ArrayOperations::instrumentationName(config.instrumentation)
+       << ", підрахунок вузького діапазону: " << (config.fastPath == FastPath::Auto ? "auto" : "off") << "\n";
+  cout << "Час у мілісекундах\n\n";
+
+  cout << left << setw(20) << "algorithm" << setw(15) << "distribution" << right << setw(9) << "size" << setw(8) << "threads"
+       << setw(12) << "median" << setw(12) << "p95" << setw(12) << "mean" << setw(11) << "stddev"
+       << setw(26) << "95% CI" << endl;
+  cout << string(125, '-') << endl;
+
+  vector<BenchmarkRow> rows;
+  NullBuffer nullBuffer;
+
+  for (const string &name : config.algorithms)
+  {
+    const SortAlgorithm &algorithm = SortRegistry::find(name);
+    for (Distribution distribution : config.distributions)
+    {
+      for (int size : config.sizes)
+      {
+        DistributionParams params;
+        params.maxValue = 1000000;
+        vector<int> source = ArrayOperations::generateArray(size, distribution, params, config.seed);
+
+        // Послідовні алгоритми не залежать від кількості потоків
+        vector<int> threadCounts = algorithm.parallel ? config.threadCounts : vector<int>{0};
+        for (int threads : threadCounts)
+        {
+          SortOptions options;
+          options.numThreads = threads;
+          options.instrumentation = config.instrumentation;
+          options.fastPath = config.fastPath;
+
+          streambuf *console = cout.rdbuf(&nullBuffer);
+          TrialStats stats;
+          try
+          {
+            stats = measure(algorithm, source, options, config.warmup, config.trials);
+          }
+          catch (...)
+          {
+            cout.rdbuf(console);
+            throw;
+          }
+          cout.rdbuf(console);
+
+          BenchmarkRow row = {name, ArrayGenerator::distributionName(distribution), size, threads, stats};
+          rows.push_back(row);
+
+          ostringstream interval;
+          interval << fixed << setprecision(3) << "[" << stats.ciLowMs << ", " << stats.ciHighMs << "]";
+          cout << left << setw(20) << name << setw(15) << row.distribution << right << setw(9) << size
+               << setw(8) << (threads > 0 ? to_string(threads) : "-")
+               << fixed << setprecision(3) << setw(12) << stats.medianMs << setw(12) << stats.p95Ms
+               << setw(12) << stats.meanMs << setw(11) << stats.stddevMs << setw(26) << interval.str() << endl;
+        }
+      }
+    }
+  }
+
+  ofstream csv(config.csvFile);
+  if (!csv.is_open())
+  {
+    throw runtime_error("Неможливо відкрити файл для запису: " + config.csvFile);
+  }
+  csv << "algorithm,distribution,size,threads,instrumentation,fast_path,seed,warmup,trials,"
+      << "median_ms,p95_ms,mean_ms,stddev_ms,ci95_low_ms,ci95_high_ms,min_ms,max_ms\n";
+  for (const auto &row : rows)
+  {
+    const TrialStats &s = row.stats;
+    csv << row.algorithm << "," << row.distribution << "," << row.size << "," << row.threads << ","
+        << ArrayOperations::instrumentationName(config.instrumentation) << ","
+        << (config.fastPath == FastPath::Auto ? "auto" : "off") << "," << config.seed << ","
+        << config.warmup << "," << s.trials << "," << fixed << setprecision(6)
+        << s.medianMs << "," << s.p95Ms << "," << s.meanMs << "," << s.stddevMs << ","
+        << s.ciLowMs << "," << s.ciHighMs << "," << s.minMs << "," << s.maxMs << "\n";
+  }
+  cout << "\nРезультати збережено у " << config.csvFile << endl;
+  return 0;
+}
+
+// Мінімальний час сортування копії масиву з кількох повторів
+double measureBubbleSort(const vector<int> &source, Instrumentation instrumentation, int repetitions)
+{
+  double best = 0;
+  for (int r = 0; r < repetitions; r++)
+  {
+    vector<int> array = source;
+    // Вимірюється саме бульбашка, без сортування підрахунком
+    SortMetrics metrics = ArrayOperations::bubbleSort(array, instrumentation, FastPath::Disabled);
+    if (r == 0 || metrics.executionTimeMs < best)
+    {
+      best = metrics.executionTimeMs;
+    }
+  }
+  return best;
+}
+
+// Вартість політик інструментування послідовного сортування
+int runInstrumentationOverhead()
+{
+  const int sizes[] = {1000, 5000, 20000};
+  const int repetitions = 3;
+  const int maxTraceSize = 1000; // Трасування на більших масивах генерує сотні мільйонів рядків
+  const uint64_t seed = 20240601; // Фіксований seed: усі запуски сортують ті самі масиви
+
+  cout << "===== ВАРТІСТЬ ІНСТРУМЕНТУВАННЯ ПОСЛІДОВНОГО СОРТУВАННЯ =====\n";
+  cout << "Seed масивів: " << seed << "\n";
+  cout << right << setw(10) << "Розмір"
+       << setw(16) << "none (мс)"
+       << setw(16) << "counters (мс)"
+       << setw(16) << "timeline (мс)"
+       << setw(16) << "trace (мс)"
+       << setw(18) << "counters/none"
+       << setw(18) << "timeline/none"
+       << setw(16) << "trace/none" << endl;
+  cout << string(126, '-') << endl;
+
+  for (int size : sizes)
+  {
+    vector<int> source = ArrayOperations::generateRandomArray(size, 0, 1000000, seed);
+
+    double noneMs = measureBubbleSort(source, Instrumentation::None, repetitions);
+    double countersMs = measureBubbleSort(source, Instrumentation::Counters, repetitions);
+    double timelineMs = measureBubbleSort(source, Instrumentation::Timeline, repetitions);
+
+    cout << right << setw(10) << size
+         << setw(16) << fixed << setprecision(3) << noneMs
+         << setw(16) << countersMs
+         << setw(16) << timelineMs;
+
+    if (size <= maxTraceSize)
+    {
+      // Трасування вимірюється з виводом у порожній буфер: враховується вартість форматування, а не термінала
+      ostringstream sink;
+      streambuf *original = cout.rdbuf(sink.rdbuf());
+      double traceMs = measureBubbleSort(source, Instrumentation::Trace, 1);
+      cout.rdbuf(original);
+
+      cout << setw(16) << traceMs
+           << setw(18) << setprecision(2) << countersMs / noneMs
+           << setw(18) << timelineMs / noneMs
+           << setw(16) << traceMs / noneMs << endl;
+    }
+    else
+    {
+      cout << setw(16) << "-"
+           << setw(18) << setprecision(2) << countersMs / noneMs
+           << setw(18) << timelineMs / noneMs
+           << setw(16) << "-" << endl;
+    }
+  }
+
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  try
+  {
+    for (int i = 1; i < argc; i++)
+    {
+      string option = argv[i];
+      if (option == "--help")
+      {
+        printUsage();
+        return 0;
+      }
+      if (option == "--overhead")
+      {
+        return runInstrumentationOverhead();
+      }
+    }
+
+    return runMatrix(parseArguments(argc, argv));
+  }
+  catch (const exception &e)
+  {
+    cerr << "Помилка: " << e.what() << endl;
+    return 1;
+  }
+}
@@ -0,0 +1,113 @@
+#include "CommandLine.h"
+#include <sstream>
+#include <stdexcept>
+
+string CommandLine::readOption(int argc, char *argv[], int &i, string &option)
+{
+  option = argv[i];
+
+  // Підтримуються форми "--key value" і "--key=value"
+  size_t equals = option.find('=');
+  if (equals != string::npos)
+  {
+    string value = option.substr(equals + 1);
+    option = option.substr(0, equals);
+    return value;
+  }
+
+  if (i + 1 >= argc)
+  {
+    throw runtime_error("Параметр " + option + " потребує значення");
+  }
+  return argv[++i];
+}
+
+vector<string> CommandLine::splitList(const string &value)
+{
+  vector<string> items;
+  stringstream stream(value);
+  string item;
+  while (getline(stream, item, ','))
+  {
+    if (!item.empty())
+    {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+int CommandLine::parseInt(const string &option, const string &value, long long minValue)
+{
+  size_t parsed = 0;
+  long long result = 0;
+  try
+  {
+    result = stoll(value, &parsed);
+  }
+  catch (const exception &)
+  {
+  }
+  if (parsed == 0 || parsed != value.size())
+  {
+    throw runtime_error("Некоректне значення параметра " + option + ": " + value);
+  }
+  if (result < minValue || result > INT32_MAX)
+  {
+    throw runtime_error("Значення параметра " + option + " поза допустимими межами: " + value);
+  }
+  return static_cast<int>(result);
+}
+
+uint64_t CommandLine::parseSeed(const string &option, const string &value)
+{
+  // stoull приймає знак мінус, тому від'ємні значення відкидаються окремо
+  size_t parsed = 0;
+  uint64_t result = 0;
+  if (!value.empty() && value[0] != '-')
+  {
+    try
+    {
+      result = stoull(value, &parsed);
+    }
+    catch (const exception &)
+    {
+    }
+  }
+  if (parsed == 0 || parsed != value.size())
+  {
+    throw runtime_error("Некоректне значення параметра " + option + ": " + value);
+  }
+  return result;
+}
+
+Instrumentation CommandLine::parseInstrumentation(const string &value)
+{
+  const Instrumentation modes[] = {Instrumentation::None, Instrumentation::Counters, Instrumentation::Trace, Instrumentation::Timeline};
+  for (Instrumentation mode : modes)
+  {
+    if (ArrayOperations::instrumentationName(mode) == value)
+    {
+      return mode;
+    }
+  }
+  throw runtime_error("Невідомий режим інструментування: " + value + " (доступні: none, counters, trace, timeline)");
+}
+
+FastPath CommandLine::parseFastPath(const string &value)
+{
+  if (value == "auto")
+    return FastPath::Auto;
+  if (value == "off")
+    return FastPath::Disabled;
+  throw runtime_error("Невідомий режим --fast-path: " + value + " (доступні: auto, off)");
+}
+
+ArrayFileFormat CommandLine::parseFileFormat(const string &value)
+{
+  if (value == "text")
+    return ArrayFileFormat::Text;
+  if (value == "binary")
+    return ArrayFileFormat::Binary;
+  throw runtime_error("Невідомий формат файлу: " + value + " (доступні: text, binary)");
+}
@@ -0,0 +1,49 @@
+#ifndef COMMAND_LINE_H
+#define COMMAND_LINE_H
+
+#include <vector>
+#include <string>
+#include <streambuf>
+#include <cstdint>
+#include "ArrayOperations.h"
+
+using namespace std;
+
+// Stream buffer that discards everything; hides the console messages of the
+// sort engines while their results are measured or written
+class NullBuffer : public streambuf
+{
+protected:
+  int overflow(int c) override { return c; }
+};
+
+// Option parsing shared by the batch mode and the benchmark. Every parser
+// throws runtime_error with a message naming the option and the valid values.
+class CommandLine
+{
+public:
+  // Read argv[i] as "--key value" or "--key=value": option receives the key,
+  // the value comes from the same or the next argument, and i is advanced
+  // past it. Throws when the value is missing.
+  static string readOption(int argc, char *argv[], int &i, string &option);
+
+  // Non-empty items of a comma-separated list
+  static vector<string> splitList(const string &value);
+
+  // Whole-string integer between minValue and INT32_MAX
+  static int parseInt(const string &option, const string &value, long long minValue);
+
+  // Non-negative 64-bit seed
+  static uint64_t parseSeed(const string &option, const string &value);
+
+  // none, counters, trace or timeline
+  static Instrumentation parseInstrumentation(const string &value);
+
+  // auto or off
+  static FastPath parseFastPath(const string &value);
+
+  // text or binary
+  static ArrayFileFormat parseFileFormat(const string &value);
+};
+
+#endif // COMMAND_LINE_H
@@ -0,0 +1,117 @@
+#ifndef ELEMENT_ORDER_H
+#define ELEMENT_ORDER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+
+using namespace std;
+
+// Ascending order used by the sort engines when no comparator is given
+template <typename T>
+struct NaturalOrder
+{
+  bool operator()(const T &a, const T &b) const { return a < b; }
+};
+
+// Floating point: NaN is greater than every number and equal to other NaNs,
+// so every array has a sorted order and NaNs end up at the end
+template <>
+struct NaturalOrder<float>
+{
+  bool operator()(float a, float b) const { return a < b || (b != b && a == a); }
+};
+
+template <>
+struct NaturalOrder<double>
+{
+  bool operator()(double a, double b) const { return a < b || (b != b && a == a); }
+};
+
+// Compare-exchange of two elements: puts the smaller one in a, returns whether
+// they were out of order. Both values are selected without a branch.
+template <typename T, typename Less>
+inline bool orderPair(T &a, T &b, const Less &less)
+{
+  T first = a;
+  T second = b;
+  bool outOfOrder = less(second, first);
+  a = outOfOrder ? second : first;
+  b = outOfOrder ? first : second;
+  return outOfOrder;
+}
+
+// Integers in natural order: min/max instructions
+template <typename T>
+inline typename enable_if<is_integral<T>::value, bool>::type orderPair(T &a, T &b, const NaturalOrder<T> &)
+{
+  T first = a;
+  T second = b;
+  a = min(first, second);
+  b = max(first, second);
+  return first > second;
+}
+
+// (key, payload) record; the payload moves together with the key
+template <typename Key, typename Payload>
+struct Record
+{
+  Key key;
+  Payload payload;
+};
+
+template <typename Key, typename Payload>
+ostream &operator<<(ostream &out, const Record<Key, Payload> &record)
+{
+  return out << record.key << ":" << record.payload;
+}
+
+// Key extractor for Record
+struct RecordKey
+{
+  template <typename Key, typename Payload>
+  const Key &operator()(const Record<Key, Payload> &record) const { return record.key; }
+};
+
+// Order of elements by the natural order of an extracted key
+template <typename KeyOf>
+struct KeyOrder
+{
+  KeyOf keyOf;
+
+  KeyOrder(KeyOf keyOf = KeyOf()) : keyOf(keyOf) {}
+
+  template <typename T>
+  bool operator()(const T &a, const T &b) const
+  {
+    typedef typename decay<decltype(keyOf(a))>::type Key;
+    return NaturalOrder<Key>()(keyOf(a), keyOf(b));
+  }
+};
+
+// Element types supported by the array files
+enum class ElementKind : uint8_t
+{
+  SignedInteger = 0, // Нуль - для сумісності з файлами, де це поле було резервним
+  Float = 1
+};
+
+template <typename T>
+struct ElementTraits
+{
+  static_assert(is_arithmetic<T>::value, "array files store numbers only");
+
+  static const ElementKind kind = is_floating_point<T>::value ? ElementKind::Float : ElementKind::SignedInteger;
+  static const uint8_t width = sizeof(T);
+};
+
+// Name of a file element type ("int32", "float64", ...)
+inline const char *elementTypeName(ElementKind kind, int width)
+{
+  if (kind == ElementKind::Float)
+    return width == 4 ? "float32" : width == 8 ? "float64" : "float?";
+  return width == 4 ? "int32" : width == 8 ? "int64" : "int?";
+}
+
+#endif // ELEMENT_ORDER_H
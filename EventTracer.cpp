@@ -0,0 +1,248 @@
+#include "EventTracer.h"
+#include "ThreadPool.h"
+#include <mutex>
+#include <memory>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/syscall.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+atomic<bool> EventTracer::tracing(false);
+
+namespace
+{
+  // Кільцевий буфер одного потоку: пише лише власник, читається після stop()
+  struct ThreadBuffer
+  {
+    pid_t threadId;
+    vector<TraceRecord> records;
+    atomic<uint64_t> written;
+
+    explicit ThreadBuffer(size_t capacity) : threadId(0), records(capacity), written(0) {}
+  };
+
+  mutex registryMutex;
+  vector<unique_ptr<ThreadBuffer>> buffers; // Буфери потоків поточної сесії
+  vector<unique_ptr<ThreadBuffer>> spare;   // Виділені заздалегідь, ще не зайняті потоками
+  size_t capacityMask = 0;
+  atomic<unsigned> generation(0);
+  pid_t sessionThreadId = 0;
+
+  thread_local ThreadBuffer *localBuffer = nullptr;
+  thread_local unsigned localGeneration = 0;
+
+  // Калібрування тактів TSC за steady_clock на початку і в кінці сесії
+  uint64_t startTimestamp = 0;
+  uint64_t stopTimestamp = 0;
+  chrono::steady_clock::time_point startTime;
+  chrono::steady_clock::time_point stopTime;
+
+  uint64_t readTimestamp()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+  }
+
+  // Буфер поточного потоку в цій сесії; береться із запасу без виділення пам'яті, якщо можливо
+  ThreadBuffer *threadBuffer()
+  {
+    unsigned current = generation.load(memory_order_acquire);
+    if (localGeneration == current)
+      return localBuffer;
+
+    lock_guard<mutex> lock(registryMutex);
+    unique_ptr<ThreadBuffer> buffer;
+    if (!spare.empty())
+    {
+      buffer = move(spare.back());
+      spare.pop_back();
+    }
+    else
+    {
+      buffer.reset(new ThreadBuffer(capacityMask + 1));
+    }
+    buffer->threadId = static_cast<pid_t>(syscall(SYS_gettid));
+
+    localBuffer = buffer.get();
+    localGeneration = current;
+    buffers.push_back(move(buffer));
+    return localBuffer;
+  }
+}
+
+void EventTracer::start(int numThreads, size_t eventsPerThread)
+{
+  size_t capacity = 1;
+  while (capacity < eventsPerThread)
+    capacity <<= 1;
+
+  // Буфери для потоків сортування виділяються до його початку
+  int numBuffers = numThreads > 0 ? numThreads : ThreadPool::instance().size() + 1;
+
+  lock_guard<mutex> lock(registryMutex);
+  tracing.store(false, memory_order_relaxed);
+  buffers.clear();
+  spare.clear();
+  capacityMask = capacity - 1;
+  for (int i = 0; i < numBuffers; i++)
+  {
+    spare.push_back(unique_ptr<ThreadBuffer>(new ThreadBuffer(capacity)));
+  }
+
+  sessionThreadId = static_cast<pid_t>(syscall(SYS_gettid));
+  generation.fetch_add(1, memory_order_release);
+  startTime = chrono::steady_clock::now();
+  startTimestamp = readTimestamp();
+  tracing.store(true, memory_order_release);
+}
+
+void EventTracer::stop()
+{
+  tracing.store(false, memory_order_release);
+  stopTimestamp = readTimestamp();
+  stopTime = chrono::steady_clock::now();
+
+  // Незайняті буфери більше не потрібні
+  lock_guard<mutex> lock(registryMutex);
+  spare.clear();
+}
+
+void EventTracer::append(TracePoint point, TraceKind kind, int64_t arg)
+{
+  ThreadBuffer *buffer = threadBuffer();
+  uint64_t index = buffer->written.load(memory_order_relaxed);
+
+  TraceRecord &record = buffer->records[index & capacityMask];
+  record.timestamp = readTimestamp();
+  record.arg = arg;
+  record.point = point;
+  record.kind = kind;
+
+  buffer->written.store(index + 1, memory_order_release);
+}
+
+long long EventTracer::recordedEvents()
+{
+  lock_guard<mutex> lock(registryMutex);
+  long long total = 0;
+  for (const auto &buffer : buffers)
+  {
+    total += min<uint64_t>(buffer->written.load(memory_order_acquire), capacityMask + 1);
+  }
+  return total;
+}
+
+long long EventTracer::droppedEvents()
+{
+  lock_guard<mutex> lock(registryMutex);
+  long long total = 0;
+  for (const auto &buffer : buffers)
+  {
+    uint64_t written = buffer->written.load(memory_order_acquire);
+    if (written > capacityMask + 1)
+      total += written - (capacityMask + 1);
+  }
+  return total;
+}
+
+string EventTracer::pointName(TracePoint point)
+{
+  switch (point)
+  {
+  case TracePoint::Sort:
+    return "sort";
+  case TracePoint::Setup:
+    return "setup";
+  case TracePoint::SegmentSort:
+    return "segment-sort";
+  case TracePoint::Merge:
+    return "merge";
+  case TracePoint::Pass:
+    return "pass";
+  case TracePoint::Steal:
+    return "steal";
+  case TracePoint::Histogram:
+    return "histogram";
+  case TracePoint::Scatter:
+    return "scatter";
+  }
+  return "unknown";
+}
+
+void EventTracer::writeChromeTrace(const string &filename)
+{
+  if (active())
+  {
+    throw runtime_error("Трасування ще триває, файл можна записати лише після завершення сортування");
+  }
+
+  ofstream file(filename);
+  if (!file.is_open())
+  {
+    throw runtime_error("Неможливо відкрити файл для запису: " + filename);
+  }
+
+  lock_guard<mutex> lock(registryMutex);
+
+  // Тактів TSC на мікросекунду за калібруванням сесії
+  double elapsedUs = chrono::duration<double, micro>(stopTime - startTime).count();
+  double ticksPerUs = elapsedUs > 0 && stopTimestamp > startTimestamp ? (stopTimestamp - startTimestamp) / elapsedUs : 1000.0;
+  long long dropped = 0;
+  pid_t processId = getpid();
+
+  file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+  bool first = true;
+
+  for (const auto &buffer : buffers)
+  {
+    string threadName = buffer->threadId == sessionThreadId ? "Викликаючий потік" : "Робітник пулу";
+    file << (first ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << processId
+         << ", \"tid\": " << buffer->threadId << ", \"args\": {\"name\": \"" << threadName << " " << buffer->threadId << "\"}}";
+    first = false;
+
+    uint64_t written = buffer->written.load(memory_order_acquire);
+    uint64_t capacity = capacityMask + 1;
+    uint64_t oldest = written > capacity ? written - capacity : 0;
+    dropped += oldest;
+
+    // Після переповнення на початку буфера можуть бути кінці подій без початку - вони пропускаються
+    int depth = 0;
+    for (uint64_t i = oldest; i < written; i++)
+    {
+      const TraceRecord &record = buffer->records[i & capacityMask];
+      if (record.kind == TraceKind::End && depth == 0)
+        continue;
+      depth += record.kind == TraceKind::Begin ? 1 : record.kind == TraceKind::End ? -1 : 0;
+
+      double timestampUs = record.timestamp >= startTimestamp ? (record.timestamp - startTimestamp) / ticksPerUs : 0;
+      const char *phase = record.kind == TraceKind::Begin ? "B" : record.kind == TraceKind::End ? "E" : "i";
+
+      file << ",\n{\"name\": \"" << pointName(record.point) << "\", \"cat\": \"sort\", \"ph\": \"" << phase << "\"";
+      if (record.kind == TraceKind::Instant)
+        file << ", \"s\": \"t\"";
+      file << ", \"ts\": " << fixed << setprecision(3) << timestampUs << ", \"pid\": " << processId
+           << ", \"tid\": " << buffer->threadId << ", \"args\": {\"arg\": " << record.arg << "}}";
+    }
+  }
+
+  file << "\n], \"otherData\": {\"droppedEvents\": " << dropped
+#if defined(__x86_64__) || defined(__i386__)
+       << ", \"timestampSource\": \"tsc\""
+#else
+       << ", \"timestampSource\": \"steady_clock\""
+#endif
+       << ", \"ticksPerMicrosecond\": " << setprecision(3) << ticksPerUs << "}}\n";
+
+  if (!file)
+  {
+    throw runtime_error("Помилка запису у файл: " + filename);
+  }
+}
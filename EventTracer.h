@@ -0,0 +1,97 @@
+#ifndef EVENT_TRACER_H
+#define EVENT_TRACER_H
+
+#include <vector>
+#include <string>
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+// What a trace event marks; stored as a number, the name is resolved only when writing the file
+enum class TracePoint : uint16_t
+{
+  Sort,        // Усе сортування на викликаючому потоці
+  Setup,       // Підготовка: сегменти, буфери, задачі
+  SegmentSort, // Задача сортування сегмента (arg - номер сегмента)
+  Merge,       // Задача злиття (arg - номер частини)
+  Pass,        // Завершено прохід ядра (arg - номер проходу)
+  Steal,       // Робітник вкрав задачу (arg - номер жертви)
+  Histogram,   // Підрахунок цифр порозрядного сортування (arg - номер цифри)
+  Scatter      // Розкладання елементів за цифрою (arg - номер цифри)
+};
+
+enum class TraceKind : uint8_t
+{
+  Begin,
+  End,
+  Instant
+};
+
+// One compact binary event in a thread's ring buffer
+struct TraceRecord
+{
+  uint64_t timestamp; // Такти TSC (або наносекунди steady_clock без TSC)
+  int64_t arg;
+  TracePoint point;
+  TraceKind kind;
+};
+
+// Low-overhead event tracing for the sort engines. Every thread writes to its
+// own fixed-size ring buffer without locks (the oldest events are overwritten
+// when it is full); timestamps come from the TSC. Recording calls are no-ops
+// while no session is active. After stop() the session can be written as a
+// Chrome trace JSON file, viewable in chrome://tracing or Perfetto.
+class EventTracer
+{
+public:
+  static const size_t DEFAULT_EVENTS_PER_THREAD = 1 << 16;
+
+  // Start a new session, discarding the previous one. Buffers for numThreads
+  // threads (0 - the calling thread and every pool worker) are allocated up
+  // front, others on their first event; capacity is rounded up to a power of two
+  static void start(int numThreads = 0, size_t eventsPerThread = DEFAULT_EVENTS_PER_THREAD);
+
+  // Stop recording; the events stay available for writeChromeTrace()
+  static void stop();
+
+  static bool active() { return tracing.load(memory_order_relaxed); }
+
+  static void begin(TracePoint point, int64_t arg = 0) { record(point, TraceKind::Begin, arg); }
+  static void end(TracePoint point, int64_t arg = 0) { record(point, TraceKind::End, arg); }
+  static void instant(TracePoint point, int64_t arg = 0) { record(point, TraceKind::Instant, arg); }
+
+  // Events kept from the last session and events lost to ring buffer overflow
+  static long long recordedEvents();
+  static long long droppedEvents();
+
+  // Write the last session in Chrome trace event format; throws runtime_error
+  static void writeChromeTrace(const string &filename);
+
+  static string pointName(TracePoint point);
+
+private:
+  static atomic<bool> tracing;
+
+  static void record(TracePoint point, TraceKind kind, int64_t arg)
+  {
+    if (active())
+      append(point, kind, arg);
+  }
+
+  static void append(TracePoint point, TraceKind kind, int64_t arg);
+};
+
+// Begin/end pair for a scope
+class TraceScope
+{
+public:
+  explicit TraceScope(TracePoint point, int64_t arg = 0) : point(point), arg(arg) { EventTracer::begin(point, arg); }
+  ~TraceScope() { EventTracer::end(point, arg); }
+
+private:
+  TracePoint point;
+  int64_t arg;
+};
+
+#endif // EVENT_TRACER_H
@@ -0,0 +1,275 @@
+#include "ExternalSort.h"
+#include "LoserTree.h"
+#include "SortMeasurement.h"
+#include <fstream>
+#include <cstdio>
+#include <climits>
+#include <stdexcept>
+#include <chrono>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+  // Послідовне читання серії (відсортовані int без заголовка) через буфер
+  class RunReader
+  {
+  public:
+    RunReader(const string &filename, size_t length, size_t bufferElements)
+        : file(filename, ios::binary), filename(filename), remaining(length), buffer(bufferElements), pos(0), len(0)
+    {
+      if (!file.is_open())
+      {
+        throw runtime_error("Неможливо відкрити тимчасовий файл: " + filename);
+      }
+    }
+
+    bool next(int &value)
+    {
+      if (pos == len && !refill())
+        return false;
+      value = buffer[pos++];
+      return true;
+    }
+
+  private:
+    ifstream file;
+    string filename;
+    size_t remaining;
+    vector<int> buffer;
+    size_t pos;
+    size_t len;
+
+    bool refill()
+    {
+      if (remaining == 0)
+        return false;
+
+      size_t n = min(remaining, buffer.size());
+      if (!file.read(reinterpret_cast<char *>(buffer.data()), n * sizeof(int)))
+      {
+        throw runtime_error("Помилка читання тимчасового файлу: " + filename);
+      }
+      remaining -= n;
+      pos = 0;
+      len = n;
+      return true;
+    }
+  };
+
+  // Тимчасові файли видаляються і після помилки
+  struct TempFiles
+  {
+    vector<string> names;
+
+    ~TempFiles()
+    {
+      for (const auto &name : names)
+      {
+        remove(name.c_str());
+      }
+    }
+  };
+
+  void writeRunFile(const string &filename, const int *data, size_t n)
+  {
+    ofstream file(filename, ios::binary);
+    file.write(reinterpret_cast<const char *>(data), n * sizeof(int));
+    file.close();
+    if (!file)
+    {
+      throw runtime_error("Помилка запису тимчасового файлу: " + filename);
+    }
+  }
+
+  // k-шляхове злиття серій; вихідний буфер передається у sink щоразу, коли заповнюється
+  void mergeRuns(vector<unique_ptr<RunReader>> &readers, size_t bufferElements,
+                 const function<void(const int *, size_t)> &sink)
+  {
+    int k = readers.size();
+    LoserTree<int> tree(k);
+    for (int i = 0; i < k; i++)
+    {
+      int value;
+      if (readers[i]->next(value))
+      {
+        tree.setSource(i, value);
+      }
+    }
+    tree.build();
+
+    vector<int> out(bufferElements);
+    size_t used = 0;
+
+    while (tree.hasWinner())
+    {
+      out[used++] = tree.top();
+      if (used == out.size())
+      {
+        sink(out.data(), used);
+        used = 0;
+      }
+
+      int value;
+      if (readers[tree.winner()]->next(value))
+      {
+        tree.replaceTop(value);
+      }
+      else
+      {
+        tree.exhaustTop();
+      }
+    }
+
+    if (used > 0)
+    {
+      sink(out.data(), used);
+    }
+  }
+}
+
+SortMetrics ExternalSort::sortFile(const string &inputFile, const string &outputFile, size_t memoryBudgetBytes,
+                                   int numThreads, ArrayFileFormat outputFormat)
+{
+  if (memoryBudgetBytes < MIN_MEMORY_BUDGET)
+  {
+    throw runtime_error("Бюджет пам'яті має бути не менше " + to_string(MIN_MEMORY_BUDGET >> 20) + " МБ");
+  }
+  if (inputFile == outputFile)
+  {
+    throw runtime_error("Вхідний і вихідний файли мають відрізнятися");
+  }
+
+  SortMetrics metrics;
+  // Вхідні дані - файл, тому пам'ять сортування - лише пік виділень
+  SortMeasurement measurement(numThreads, Instrumentation::None);
+  auto startTime = measurement.startTime();
+
+  ArrayFileReader input(inputFile);
+  size_t total = input.size();
+  size_t chunkElements = min<size_t>(memoryBudgetBytes / BYTES_PER_CHUNK_ELEMENT, INT_MAX);
+
+  TempFiles temp;
+  vector<string> runs;
+  vector<size_t> runLengths;
+  size_t ioBytes = 0;
+  bool singleChunk = false;
+
+  // Фаза 1: сортування частин, що вміщаються в бюджет, у тимчасові серії
+  vector<int> chunk;
+  while (input.read(chunk, chunkElements) > 0)
+  {
+    SortMetrics chunkMetrics = ArrayOperations::bubbleSortMultithreaded(chunk, numThreads, Instrumentation::None, SegmentKernel::Simd);
+    metrics.additionalInfo["numThreads"] = chunkMetrics.additionalInfo["numThreads"];
+    metrics.additionalInfo["segmentKernel"] = chunkMetrics.additionalInfo["segmentKernel"];
+
+    // Увесь файл вмістився в одну частину - записуємо результат одразу
+    if (runs.empty() && chunk.size() == total)
+    {
+      ArrayFileWriter output(outputFile, outputFormat, total);
+      output.write(chunk.data(), chunk.size());
+      output.finish();
+      ioBytes += output.bytesWritten();
+      singleChunk = true;
+      break;
+    }
+
+    string name = outputFile + ".run" + to_string(temp.names.size()) + ".tmp";
+    temp.names.push_back(name);
+    writeRunFile(name, chunk.data(), chunk.size());
+    runs.push_back(name);
+    runLengths.push_back(chunk.size());
+    ioBytes += chunk.size() * sizeof(int);
+  }
+  ioBytes += input.bytesRead();
+  vector<int>().swap(chunk);
+
+  auto runsEndTime = chrono::high_resolution_clock::now();
+  int numRuns = singleChunk ? 1 : runs.size();
+
+  // Фаза 2: злиття групами по fanIn серій, поки не залишиться одна група
+  int fanIn = static_cast<int>(min<size_t>(MAX_FAN_IN, max<size_t>(2, memoryBudgetBytes / MIN_MERGE_BUFFER_BYTES - 1)));
+  int mergePasses = 0;
+
+  while (!runs.empty())
+  {
+    bool finalPass = static_cast<int>(runs.size()) <= fanIn;
+    vector<string> nextRuns;
+    vector<size_t> nextLengths;
+    mergePasses++;
+
+    for (size_t group = 0; group < runs.size(); group += fanIn)
+    {
+      size_t groupEnd = min(group + fanIn, runs.size());
+      int k = groupEnd - group;
+
+      // Бюджет ділиться між буферами k вхідних серій і вихідним буфером
+      size_t bufferElements = max<size_t>(size_t(MIN_MERGE_BUFFER_BYTES), memoryBudgetBytes / (k + 1)) / sizeof(int);
+
+      vector<unique_ptr<RunReader>> readers;
+      size_t groupLength = 0;
+      for (size_t i = group; i < groupEnd; i++)
+      {
+        readers.push_back(unique_ptr<RunReader>(new RunReader(runs[i], runLengths[i], bufferElements)));
+        groupLength += runLengths[i];
+      }
+      ioBytes += groupLength * sizeof(int);
+
+      if (finalPass)
+      {
+        ArrayFileWriter output(outputFile, outputFormat, total);
+        mergeRuns(readers, bufferElements, [&](const int *data, size_t n)
+                  { output.write(data, n); });
+        output.finish();
+        ioBytes += output.bytesWritten();
+      }
+      else
+      {
+        string name = outputFile + ".run" + to_string(temp.names.size()) + ".tmp";
+        temp.names.push_back(name);
+        ofstream file(name, ios::binary);
+        mergeRuns(readers, bufferElements, [&](const int *data, size_t n)
+                  { file.write(reinterpret_cast<const char *>(data), n * sizeof(int)); });
+        file.close();
+        if (!file)
+        {
+          throw runtime_error("Помилка запису тимчасового файлу: " + name);
+        }
+        nextRuns.push_back(name);
+        nextLengths.push_back(groupLength);
+        ioBytes += groupLength * sizeof(int);
+      }
+
+      // Злиті серії більше не потрібні
+      readers.clear();
+      for (size_t i = group; i < groupEnd; i++)
+      {
+        remove(runs[i].c_str());
+      }
+    }
+
+    if (finalPass)
+      break;
+    runs.swap(nextRuns);
+    runLengths.swap(nextLengths);
+  }
+
+  auto endTime = measurement.finish(metrics);
+
+  metrics.additionalInfo["instrumentation"] = ArrayOperations::instrumentationName(Instrumentation::None);
+  ostringstream sortPhase;
+  sortPhase << fixed << setprecision(3) << chrono::duration<double, milli>(runsEndTime - startTime).count();
+  ostringstream mergePhase;
+  mergePhase << fixed << setprecision(3) << chrono::duration<double, milli>(endTime - runsEndTime).count();
+  metrics.additionalInfo["sortPhaseMs"] = sortPhase.str();
+  metrics.additionalInfo["mergePhaseMs"] = mergePhase.str();
+  metrics.additionalInfo["runs"] = to_string(numRuns);
+  metrics.additionalInfo["mergePasses"] = to_string(mergePasses);
+  metrics.additionalInfo["ioBytes"] = to_string(ioBytes);
+  metrics.additionalInfo["memoryBudget"] = to_string(memoryBudgetBytes);
+
+  return metrics;
+}
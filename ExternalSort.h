@@ -0,0 +1,36 @@
+#ifndef EXTERNAL_SORT_H
+#define EXTERNAL_SORT_H
+
+#include <string>
+#include "ArrayOperations.h"
+
+using namespace std;
+
+// Sort of array files larger than the available memory.
+// Phase 1 reads the input in chunks that fit the memory budget, sorts every
+// chunk with the multithreaded engine (SIMD segment kernel) and writes it to a
+// temporary run file. Phase 2 merges up to MAX_FAN_IN runs at a time with a
+// loser tree, streaming each run through its own buffer. Merge passes repeat
+// until the remaining runs fit one merge, which writes the output file.
+class ExternalSort
+{
+public:
+  // Smallest accepted memory budget
+  static const size_t MIN_MEMORY_BUDGET = 1 << 20;
+
+  // Sort inputFile (text or binary) into outputFile. memoryBudgetBytes bounds
+  // the data buffers; temporary runs are created next to the output file.
+  static SortMetrics sortFile(const string &inputFile, const string &outputFile, size_t memoryBudgetBytes,
+                              int numThreads = 0, ArrayFileFormat outputFormat = ArrayFileFormat::Binary);
+
+  // Memory per chunk element: the chunk, the engine's merge buffer and SIMD scratch
+  static const size_t BYTES_PER_CHUNK_ELEMENT = 3 * sizeof(int);
+
+  // Runs merged at once (one open file and one buffer per run)
+  static const int MAX_FAN_IN = 256;
+
+  // Smallest read buffer of one run during a merge
+  static const size_t MIN_MERGE_BUFFER_BYTES = 1 << 16;
+};
+
+#endif // EXTERNAL_SORT_H
@@ -0,0 +1,247 @@
+#include "HardwareCounters.h"
+#include "ThreadPool.h"
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+  // Значення лічильника разом з часом, коли подія була увімкнена і реально рахувалась
+  struct CounterReading
+  {
+    uint64_t value;
+    uint64_t timeEnabled;
+    uint64_t timeRunning;
+  };
+
+  string paranoidLevel()
+  {
+    ifstream file("/proc/sys/kernel/perf_event_paranoid");
+    string level;
+    if (file >> level)
+      return level;
+    return "?";
+  }
+
+  string openErrorReason(int error)
+  {
+    switch (error)
+    {
+    case EACCES:
+    case EPERM:
+      return "доступ заборонено (perf_event_paranoid = " + paranoidLevel() + ")";
+    case ENOENT:
+    case EOPNOTSUPP:
+      return "процесор або віртуальна машина не надає апаратних подій";
+    case ENOSYS:
+      return "ядро зібране без perf_event";
+    case EMFILE:
+    case ENFILE:
+      return "вичерпано ліміт відкритих файлів";
+    default:
+      return strerror(error);
+    }
+  }
+}
+
+double HardwareCounts::ipc() const
+{
+  long long cycles = get(HardwareEvent::Cycles);
+  long long instructions = get(HardwareEvent::Instructions);
+  if (cycles <= 0 || instructions < 0)
+    return -1;
+  return static_cast<double>(instructions) / cycles;
+}
+
+string HardwareCounters::eventName(HardwareEvent event)
+{
+  switch (event)
+  {
+  case HardwareEvent::Cycles:
+    return "cycles";
+  case HardwareEvent::Instructions:
+    return "instructions";
+  case HardwareEvent::BranchMisses:
+    return "branchMisses";
+  case HardwareEvent::L1dMisses:
+    return "l1dMisses";
+  case HardwareEvent::LlcMisses:
+    return "llcMisses";
+  case HardwareEvent::DtlbMisses:
+    return "dtlbMisses";
+  }
+  return "unknown";
+}
+
+int HardwareCounters::openEvent(HardwareEvent event, pid_t threadId)
+{
+  perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  const uint64_t readMiss = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  switch (event)
+  {
+  case HardwareEvent::Cycles:
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    break;
+  case HardwareEvent::Instructions:
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    break;
+  case HardwareEvent::BranchMisses:
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+    break;
+  case HardwareEvent::L1dMisses:
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_L1D | readMiss;
+    break;
+  case HardwareEvent::LlcMisses:
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    break;
+  case HardwareEvent::DtlbMisses:
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | readMiss;
+    break;
+  }
+
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, threadId, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+HardwareCounters::HardwareCounters(int numThreads)
+{
+  ThreadPool::instance().ensureWorkers(numThreads - 1);
+
+  // Викликаючий потік першим: він виконує частину роботи кожного паралельного сортування
+  vector<pid_t> threadIds(1, static_cast<pid_t>(syscall(SYS_gettid)));
+  vector<pid_t> workerIds = ThreadPool::instance().threadIds();
+  threadIds.insert(threadIds.end(), workerIds.begin(), workerIds.end());
+
+  for (pid_t threadId : threadIds)
+  {
+    ThreadCounters counters;
+    counters.threadId = threadId;
+    bool anyOpened = false;
+
+    for (int e = 0; e < HardwareCounts::NUM_EVENTS; e++)
+    {
+      counters.fds[e] = openEvent(static_cast<HardwareEvent>(e), threadId);
+      if (counters.fds[e] >= 0)
+      {
+        anyOpened = true;
+      }
+      else if (threads.empty() && e == static_cast<int>(HardwareEvent::Cycles))
+      {
+        unavailableReason = openErrorReason(errno);
+      }
+    }
+
+    if (!anyOpened)
+    {
+      // Якщо викликаючий потік не має жодного лічильника, робітники їх теж не отримають
+      if (threads.empty())
+      {
+        if (unavailableReason.empty())
+          unavailableReason = openErrorReason(errno);
+        return;
+      }
+      continue;
+    }
+    threads.push_back(counters);
+  }
+  unavailableReason.clear();
+}
+
+HardwareCounters::~HardwareCounters()
+{
+  for (const auto &counters : threads)
+  {
+    for (int fd : counters.fds)
+    {
+      if (fd >= 0)
+        close(fd);
+    }
+  }
+}
+
+void HardwareCounters::start()
+{
+  for (const auto &counters : threads)
+  {
+    for (int fd : counters.fds)
+    {
+      if (fd >= 0)
+      {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+  }
+}
+
+HardwareCounterReport HardwareCounters::stop()
+{
+  for (const auto &counters : threads)
+  {
+    for (int fd : counters.fds)
+    {
+      if (fd >= 0)
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+
+  HardwareCounterReport report;
+  if (threads.empty())
+  {
+    report.unavailableReason = unavailableReason;
+    return report;
+  }
+  report.available = true;
+
+  for (const auto &counters : threads)
+  {
+    HardwareCounts counts;
+    counts.threadId = counters.threadId;
+
+    for (int e = 0; e < HardwareCounts::NUM_EVENTS; e++)
+    {
+      CounterReading reading;
+      if (counters.fds[e] < 0 || read(counters.fds[e], &reading, sizeof(reading)) != sizeof(reading))
+        continue;
+
+      if (reading.timeEnabled == 0)
+      {
+        // Потік жодного разу не виконувався під час вимірювання
+        counts.values[e] = 0;
+      }
+      else if (reading.timeRunning > 0)
+      {
+        // Якщо подій більше, ніж апаратних лічильників, ядро чергує їх; значення масштабується на повний час
+        double scale = static_cast<double>(reading.timeEnabled) / reading.timeRunning;
+        counts.values[e] = static_cast<long long>(reading.value * scale + 0.5);
+      }
+      else
+      {
+        continue;
+      }
+
+      if (report.total.values[e] < 0)
+        report.total.values[e] = 0;
+      report.total.values[e] += counts.values[e];
+    }
+    report.perThread.push_back(counts);
+  }
+
+  return report;
+}
@@ -0,0 +1,92 @@
+#ifndef HARDWARE_COUNTERS_H
+#define HARDWARE_COUNTERS_H
+
+#include <vector>
+#include <string>
+#include <sys/types.h>
+
+using namespace std;
+
+// Hardware events counted around each sort
+enum class HardwareEvent
+{
+  Cycles,
+  Instructions,
+  BranchMisses,
+  L1dMisses,  // L1 data cache read misses
+  LlcMisses,  // Last level cache misses
+  DtlbMisses  // Data TLB read misses
+};
+
+// Counter values of one thread (or the sum over threads).
+// An event that could not be counted is -1.
+struct HardwareCounts
+{
+  static const int NUM_EVENTS = 6;
+
+  pid_t threadId; // 0 for the aggregate
+  long long values[NUM_EVENTS];
+
+  HardwareCounts() : threadId(0)
+  {
+    for (int i = 0; i < NUM_EVENTS; i++)
+      values[i] = -1;
+  }
+
+  long long get(HardwareEvent event) const { return values[static_cast<int>(event)]; }
+
+  // Instructions per cycle, or -1 when either counter is missing
+  double ipc() const;
+};
+
+// Hardware counters of one sort: per thread and summed
+struct HardwareCounterReport
+{
+  bool available;
+  string unavailableReason; // Чому лічильники недоступні (якщо available == false)
+  HardwareCounts total;
+  vector<HardwareCounts> perThread;
+
+  HardwareCounterReport() : available(false) {}
+};
+
+// Linux perf_event_open counters for the calling thread and every worker of
+// the shared ThreadPool, counting user-space events only (works with
+// perf_event_paranoid <= 2). Open in the constructor, then start()/stop()
+// around the measured code. When the kernel, the virtual machine or the
+// paranoid level do not allow counting, stop() returns a report with
+// available == false and a reason instead of failing the sort.
+class HardwareCounters
+{
+public:
+  // Makes sure the pool has the numThreads - 1 workers a parallel sort will
+  // use, so that none of them is created after the counters are opened
+  explicit HardwareCounters(int numThreads = 1);
+  ~HardwareCounters();
+
+  // Reset and enable all counters
+  void start();
+
+  // Disable the counters and read them; values are scaled when the kernel multiplexed them
+  HardwareCounterReport stop();
+
+  static string eventName(HardwareEvent event);
+
+private:
+  HardwareCounters(const HardwareCounters &) = delete;
+  HardwareCounters &operator=(const HardwareCounters &) = delete;
+
+  struct ThreadCounters
+  {
+    pid_t threadId;
+    int fds[HardwareCounts::NUM_EVENTS];
+  };
+
+  vector<ThreadCounters> threads;
+  string unavailableReason;
+
+  // File descriptor of one event for one thread, -1 on failure (errno is kept)
+  static int openEvent(HardwareEvent event, pid_t threadId);
+};
+
+#endif // HARDWARE_COUNTERS_H
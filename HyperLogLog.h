@@ -0,0 +1,76 @@
+#ifndef HYPER_LOG_LOG_H
+#define HYPER_LOG_LOG_H
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+// HyperLogLog distinct-count sketch (Flajolet et al., "HyperLogLog: the
+// analysis of a near-optimal cardinality estimation algorithm", 2007) with
+// 2^PRECISION one-byte registers: about 1.6% standard error in 4 KB.
+// Small counts use the linear-counting correction. Sketches of disjoint parts
+// of the data merge by register-wise maximum, so every thread keeps its own.
+class HyperLogLog
+{
+public:
+  static const int PRECISION = 12;
+  static const int REGISTERS = 1 << PRECISION;
+
+  HyperLogLog() : registers(REGISTERS, 0) {}
+
+  // 64-bit finalizer of MurmurHash3: nearby keys differ in all bits
+  static uint64_t hash(uint64_t key)
+  {
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDULL;
+    key ^= key >> 33;
+    key *= 0xC4CEB9FE1A85EC53ULL;
+    key ^= key >> 33;
+    return key;
+  }
+
+  void add(uint64_t hashValue)
+  {
+    // Старші біти вибирають регістр, решта - позицію першої одиниці
+    int index = static_cast<int>(hashValue >> (64 - PRECISION));
+    uint64_t rest = (hashValue << PRECISION) | (uint64_t(1) << (PRECISION - 1)); // Сторожовий біт обмежує ранг
+    uint8_t rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+    registers[index] = max(registers[index], rank);
+  }
+
+  void merge(const HyperLogLog &other)
+  {
+    for (int i = 0; i < REGISTERS; i++)
+    {
+      registers[i] = max(registers[i], other.registers[i]);
+    }
+  }
+
+  double estimate() const
+  {
+    double alpha = 0.7213 / (1 + 1.079 / REGISTERS);
+    double harmonic = 0;
+    int zeros = 0;
+    for (uint8_t rank : registers)
+    {
+      harmonic += ldexp(1.0, -rank);
+      zeros += rank == 0;
+    }
+
+    double raw = alpha * REGISTERS * REGISTERS / harmonic;
+    if (raw <= 2.5 * REGISTERS && zeros > 0)
+    {
+      // Мало різних значень: точніший лінійний підрахунок порожніх регістрів
+      return REGISTERS * log(static_cast<double>(REGISTERS) / zeros);
+    }
+    return raw;
+  }
+
+private:
+  vector<uint8_t> registers;
+};
+
+#endif // HYPER_LOG_LOG_H
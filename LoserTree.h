@@ -0,0 +1,125 @@
+#ifndef LOSER_TREE_H
+#define LOSER_TREE_H
+
+#include <vector>
+#include "ElementOrder.h"
+
+using namespace std;
+
+// Tournament (loser) tree for k-way merging.
+// Each leaf holds the current head of one sorted source. The tree keeps the
+// loser of every match in its internal nodes, so replacing the winner only
+// replays the matches on one leaf-to-root path (ceil(log2 k) comparisons).
+// Ties are resolved in favour of the source with the smaller index, which
+// keeps the merge stable with respect to source order. Less is a strict
+// weak order on the keys.
+template <typename T, typename Less = NaturalOrder<T>>
+class LoserTree
+{
+public:
+  explicit LoserTree(int numSources, const Less &keyLess = Less())
+      : k(numSources), keys(numSources), alive(numSources, false), tree(numSources > 0 ? numSources : 1, 0), comparisons(0), keyLess(keyLess)
+  {
+  }
+
+  // Set the initial head of a source (call before build())
+  void setSource(int source, const T &key)
+  {
+    keys[source] = key;
+    alive[source] = true;
+  }
+
+  // Play the initial tournament
+  void build()
+  {
+    vector<int> winners(2 * k);
+    for (int i = 0; i < k; i++)
+    {
+      winners[k + i] = i;
+    }
+
+    for (int node = k - 1; node >= 1; node--)
+    {
+      int a = winners[2 * node];
+      int b = winners[2 * node + 1];
+      if (less(a, b))
+      {
+        winners[node] = a;
+        tree[node] = b;
+      }
+      else
+      {
+        winners[node] = b;
+        tree[node] = a;
+      }
+    }
+
+    tree[0] = k > 1 ? winners[1] : 0;
+  }
+
+  // True while at least one source still has elements
+  bool hasWinner() const { return k > 0 && alive[tree[0]]; }
+
+  // Source index of the current minimum
+  int winner() const { return tree[0]; }
+
+  // Current minimum
+  const T &top() const { return keys[tree[0]]; }
+
+  // Replace the winner's key with the next element of the same source
+  void replaceTop(const T &key)
+  {
+    keys[tree[0]] = key;
+    replay(tree[0]);
+  }
+
+  // Mark the winner's source as exhausted
+  void exhaustTop()
+  {
+    alive[tree[0]] = false;
+    replay(tree[0]);
+  }
+
+  long long getComparisons() const { return comparisons; }
+
+private:
+  int k;
+  vector<T> keys;
+  vector<bool> alive;
+  vector<int> tree; // tree[0] - переможець, tree[1..k-1] - переможені у внутрішніх вузлах
+  long long comparisons;
+  Less keyLess;
+
+  // Strict "a goes before b": exhausted sources lose to everything
+  bool less(int a, int b)
+  {
+    if (!alive[a])
+      return false;
+    if (!alive[b])
+      return true;
+
+    comparisons++;
+    if (keyLess(keys[a], keys[b]))
+      return true;
+    if (keyLess(keys[b], keys[a]))
+      return false;
+    return a < b;
+  }
+
+  void replay(int leaf)
+  {
+    int current = leaf;
+    for (int node = (leaf + k) / 2; node >= 1; node /= 2)
+    {
+      if (less(tree[node], current))
+      {
+        int loser = current;
+        current = tree[node];
+        tree[node] = loser;
+      }
+    }
+    tree[0] = current;
+  }
+};
+
+#endif // LOSER_TREE_H
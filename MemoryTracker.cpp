@@ -0,0 +1,234 @@
+#include "MemoryTracker.h"
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <malloc.h>
+#include <sys/resource.h>
+
+namespace
+{
+  // Лічильники ініціалізуються константою, тому готові ще до першого виклику operator new
+  atomic<size_t> heapBytes(0);
+  atomic<size_t> heapPeakBytes(0);
+  atomic<long long> heapAllocations(0);
+
+  void raisePeak(atomic<size_t> &peak, size_t value)
+  {
+    size_t current = peak.load(memory_order_relaxed);
+    while (value > current && !peak.compare_exchange_weak(current, value, memory_order_relaxed))
+    {
+    }
+  }
+
+  void recordAllocation(void *block)
+  {
+    size_t bytes = malloc_usable_size(block);
+    size_t total = heapBytes.fetch_add(bytes, memory_order_relaxed) + bytes;
+    heapAllocations.fetch_add(1, memory_order_relaxed);
+    raisePeak(heapPeakBytes, total);
+  }
+
+  void recordRelease(void *block)
+  {
+    heapBytes.fetch_sub(malloc_usable_size(block), memory_order_relaxed);
+  }
+
+  void *allocate(size_t size, size_t alignment)
+  {
+    if (size == 0)
+      size = 1;
+
+    while (true)
+    {
+      void *block = nullptr;
+      if (alignment <= alignof(max_align_t))
+        block = malloc(size);
+      else if (posix_memalign(&block, alignment, size) != 0)
+        block = nullptr;
+
+      if (block)
+      {
+        recordAllocation(block);
+        return block;
+      }
+
+      // Стандартна поведінка operator new: викликати new_handler або кинути bad_alloc
+      new_handler handler = get_new_handler();
+      if (!handler)
+        throw bad_alloc();
+      handler();
+    }
+  }
+
+  void release(void *block)
+  {
+    if (block)
+    {
+      recordRelease(block);
+      free(block);
+    }
+  }
+
+  // Значення поля "Vm...: N kB" з /proc/self/status у байтах, 0 якщо поле недоступне
+  size_t readStatusField(const string &field)
+  {
+    ifstream status("/proc/self/status");
+    string name;
+    while (status >> name)
+    {
+      if (name == field)
+      {
+        size_t kilobytes = 0;
+        status >> kilobytes;
+        return kilobytes * 1024;
+      }
+      status.ignore(4096, '\n');
+    }
+    return 0;
+  }
+}
+
+// Заміна глобальних operator new/delete: кожне виділення пам'яті в процесі проходить через лічильники
+void *operator new(size_t size) { return allocate(size, 0); }
+void *operator new[](size_t size) { return allocate(size, 0); }
+void *operator new(size_t size, align_val_t alignment) { return allocate(size, static_cast<size_t>(alignment)); }
+void *operator new[](size_t size, align_val_t alignment) { return allocate(size, static_cast<size_t>(alignment)); }
+
+void *operator new(size_t size, const nothrow_t &) noexcept
+{
+  try
+  {
+    return allocate(size, 0);
+  }
+  catch (...)
+  {
+    return nullptr;
+  }
+}
+
+void *operator new[](size_t size, const nothrow_t &) noexcept
+{
+  try
+  {
+    return allocate(size, 0);
+  }
+  catch (...)
+  {
+    return nullptr;
+  }
+}
+
+void *operator new(size_t size, align_val_t alignment, const nothrow_t &) noexcept
+{
+  try
+  {
+    return allocate(size, static_cast<size_t>(alignment));
+  }
+  catch (...)
+  {
+    return nullptr;
+  }
+}
+
+void *operator new[](size_t size, align_val_t alignment, const nothrow_t &) noexcept
+{
+  try
+  {
+    return allocate(size, static_cast<size_t>(alignment));
+  }
+  catch (...)
+  {
+    return nullptr;
+  }
+}
+
+void operator delete(void *block) noexcept { release(block); }
+void operator delete[](void *block) noexcept { release(block); }
+void operator delete(void *block, size_t) noexcept { release(block); }
+void operator delete[](void *block, size_t) noexcept { release(block); }
+void operator delete(void *block, align_val_t) noexcept { release(block); }
+void operator delete[](void *block, align_val_t) noexcept { release(block); }
+void operator delete(void *block, size_t, align_val_t) noexcept { release(block); }
+void operator delete[](void *block, size_t, align_val_t) noexcept { release(block); }
+void operator delete(void *block, const nothrow_t &) noexcept { release(block); }
+void operator delete[](void *block, const nothrow_t &) noexcept { release(block); }
+void operator delete(void *block, align_val_t, const nothrow_t &) noexcept { release(block); }
+void operator delete[](void *block, align_val_t, const nothrow_t &) noexcept { release(block); }
+
+MemoryTracker::MemoryTracker()
+    : startHeapBytes(0), outerPeakHeapBytes(0), startAllocations(0), startRssBytes(0), startPeakRssBytes(0), rssPeakReset(false)
+{
+}
+
+size_t MemoryTracker::currentHeapBytes()
+{
+  return heapBytes.load(memory_order_relaxed);
+}
+
+long long MemoryTracker::allocationCount()
+{
+  return heapAllocations.load(memory_order_relaxed);
+}
+
+size_t MemoryTracker::currentRssBytes()
+{
+  return readStatusField("VmRSS:");
+}
+
+size_t MemoryTracker::peakRssBytes()
+{
+  size_t peak = readStatusField("VmHWM:");
+  if (peak == 0)
+  {
+    // Без /proc: максимальний RSS з початку процесу (ru_maxrss у кілобайтах)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+      peak = static_cast<size_t>(usage.ru_maxrss) * 1024;
+  }
+  return peak;
+}
+
+bool MemoryTracker::resetPeakRss()
+{
+  ofstream clearRefs("/proc/self/clear_refs");
+  if (!clearRefs.is_open())
+    return false;
+  clearRefs << "5";
+  clearRefs.flush();
+  return static_cast<bool>(clearRefs);
+}
+
+void MemoryTracker::start()
+{
+  startRssBytes = currentRssBytes();
+  rssPeakReset = resetPeakRss();
+  startPeakRssBytes = peakRssBytes();
+
+  startAllocations = allocationCount();
+  startHeapBytes = currentHeapBytes();
+  outerPeakHeapBytes = heapPeakBytes.exchange(startHeapBytes, memory_order_relaxed);
+}
+
+MemoryUsage MemoryTracker::stop()
+{
+  MemoryUsage usage;
+
+  size_t peak = heapPeakBytes.load(memory_order_relaxed);
+  usage.peakHeapBytes = peak > startHeapBytes ? peak - startHeapBytes : 0;
+  usage.allocations = allocationCount() - startAllocations;
+
+  // Зовнішнє вимірювання не повинно втратити свій пік
+  raisePeak(heapPeakBytes, outerPeakHeapBytes);
+
+  usage.peakRssBytes = peakRssBytes();
+  usage.rssPeakExact = rssPeakReset;
+  if (rssPeakReset || usage.peakRssBytes > startPeakRssBytes)
+  {
+    // Пік скинуто на початку (або перевищено попередній), тому різниця - приріст під час вимірювання
+    usage.peakRssDeltaBytes = static_cast<long long>(usage.peakRssBytes) - static_cast<long long>(startRssBytes);
+  }
+
+  return usage;
+}
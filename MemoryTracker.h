@@ -0,0 +1,59 @@
+#ifndef MEMORY_TRACKER_H
+#define MEMORY_TRACKER_H
+
+#include <cstddef>
+
+using namespace std;
+
+// Measured memory of one sort
+struct MemoryUsage
+{
+  size_t peakHeapBytes;        // Пік heap-пам'яті понад рівень на початку вимірювання
+  long long allocations;       // Кількість виділень під час вимірювання
+  size_t peakRssBytes;         // Пік RSS процесу під час вимірювання (або з початку процесу)
+  long long peakRssDeltaBytes; // Пік RSS мінус RSS на початку вимірювання
+  bool rssPeakExact;           // false - пік RSS не вдалося скинути, приріст є нижньою оцінкою
+
+  MemoryUsage() : peakHeapBytes(0), allocations(0), peakRssBytes(0), peakRssDeltaBytes(0), rssPeakExact(false) {}
+};
+
+// Heap accounting through replaced global operator new/delete (MemoryTracker.cpp)
+// plus process RSS from /proc/self/status. start()/stop() around the measured
+// code give the peak heap bytes allocated in between and the peak RSS growth.
+// The heap counters are process-wide: allocations of unrelated threads made
+// during the measurement are counted too. Heap measurements may be nested;
+// the RSS peak of an enclosing measurement only covers what is still visible
+// after the nested one reset the kernel's high-water mark.
+class MemoryTracker
+{
+public:
+  MemoryTracker();
+
+  // Remember the current levels and reset the peaks
+  void start();
+
+  // Peaks since start(); restores the peak of an enclosing measurement
+  MemoryUsage stop();
+
+  // Bytes currently allocated through operator new (usable size of each block)
+  static size_t currentHeapBytes();
+
+  static long long allocationCount();
+
+  // Resident set size and its high-water mark, 0 when unavailable
+  static size_t currentRssBytes();
+  static size_t peakRssBytes();
+
+private:
+  size_t startHeapBytes;
+  size_t outerPeakHeapBytes;
+  long long startAllocations;
+  size_t startRssBytes;
+  size_t startPeakRssBytes;
+  bool rssPeakReset;
+
+  // Reset the kernel's RSS high-water mark (/proc/self/clear_refs, Linux 4.0+)
+  static bool resetPeakRss();
+};
+
+#endif // MEMORY_TRACKER_H
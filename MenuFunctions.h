@@ -6,6 +6,7 @@
 #include <string>
 #include <limits>
 #include <iomanip>
+#include <sstream>
 
 using namespace std;
 
@@ -50,33 +51,57 @@ bool getYesNoInput(const string &prompt)
   return !input.empty() && (input[0] == 'y' || input[0] == 'Y');
 }
 
+// Виведення швидкості читання або запису файлу
+void printIoStats(const IoStats &stats)
+{
+  cout << "Оброблено " << fixed << setprecision(2) << stats.bytes / (1024.0 * 1024.0) << " МБ за "
+       << setprecision(3) << stats.timeMs << " мс (" << setprecision(3) << stats.throughputGBs() << " ГБ/с, "
+       << stats.numThreads << " потоків)\n";
+}
+
 // Функція для збереження масиву у файл
 void saveArrayToFile(const vector<int> &array)
 {
   string filename = getStringInput("Введіть ім'я файлу для збереження: ");
-  ArrayOperations::saveArrayToFile(array, filename);
+  ArrayFileFormat format = getYesNoInput("Зберегти у бінарному форматі (швидке завантаження великих масивів)?")
+                               ? ArrayFileFormat::Binary
+                               : ArrayFileFormat::Text;
+  IoStats saveStats;
+  ArrayOperations::saveArrayToFile(array, filename, format, &saveStats);
+  printIoStats(saveStats);
 }
 
 // Функція для виведення інформації про масив
 void printArrayInfo(const vector<int> &array)
 {
+  // Усі характеристики збираються одним паралельним проходом
+  ArrayStatistics<int> stats = ArrayOperations::scanArray(array);
+
   cout << "=== Інформація про масив ===\n";
-  cout << "Розмір масиву: " << array.size() << " елементів\n";
+  cout << "Розмір масиву: " << stats.size << " елементів\n";
 
-  if (!array.empty())
+  if (stats.size > 0)
   {
-    int minVal = array[0], maxVal = array[0];
-    for (int val : array)
+    cout << "Найменше значення: " << stats.minValue << endl;
+    cout << "Найбільше значення: " << stats.maxValue << endl;
+    cout << "Сума: " << stats.sum << ", середнє: " << fixed << setprecision(3)
+         << static_cast<double>(stats.sum) / stats.size << endl;
+    cout << "Різних значень: ~" << static_cast<long long>(stats.distinctEstimate + 0.5) << " (оцінка)\n";
+    cout << "Неспадних серій: " << stats.runCount << endl;
+
+    if (stats.sorted)
     {
-      minVal = min(minVal, val);
-      maxVal = max(maxVal, val);
+      cout << "Стан: відсортований\n";
+    }
+    else
+    {
+      cout << "Стан: НЕ відсортований (перше порушення порядку на індексі " << stats.firstUnsortedIndex << ")\n";
     }
-    cout << "Найменше значення: " << minVal << endl;
-    cout << "Найбільше значення: " << maxVal << endl;
   }
 
   size_t memUsage = ArrayOperations::calculateMemoryUsage(array);
   cout << "Використана пам'ять: " << memUsage << " байт\n";
+  cout << "Час аналізу: " << fixed << setprecision(3) << stats.scanMs << " мс\n";
 }
 
 // Структура для зберігання результатів сортування
@@ -113,9 +138,12 @@ void compareSortResults(const vector<SortResult> &results)
        << right << setw(15) << "Час (мс)"
        << right << setw(17) << "% від найкр."
        << right << setw(15) << "Порівняння"
-       << right << setw(15) << "Обміни" << endl;
+       << right << setw(15) << "Обміни"
+       << right << setw(8) << "IPC"
+       << right << setw(15) << "Пром. перех."
+       << right << setw(15) << "LLC-промахи" << endl;
 
-  cout << string(95, '-') << endl;
+  cout << string(133, '-') << endl;
 
   // Вивід даних в таблиці
   for (const auto &result : results)
@@ -126,8 +154,38 @@ void compareSortResults(const vector<SortResult> &results)
          << right << setw(12) << result.numThreads
          << right << setw(15) << fixed << setprecision(3) << result.metrics.executionTimeMs
          << right << setw(17) << fixed << setprecision(2) << timePercent
-         << right << setw(15) << result.metrics.comparisons
-         << right << setw(15) << result.metrics.swaps << endl;
+         << right << setw(15);
+
+    // Лічильники лише злиття (векторне ядро сегментів) не порівнюються з повними
+    auto scope = result.metrics.additionalInfo.find("counterScope");
+    if (scope != result.metrics.additionalInfo.end() && scope->second == "merge")
+    {
+      cout << "n/a" << right << setw(15) << "n/a";
+    }
+    else
+    {
+      cout << result.metrics.comparisons << right << setw(15) << result.metrics.swaps;
+    }
+
+    // Апаратні лічильники: "-", якщо вони недоступні або подія не рахувалась
+    const HardwareCounts &hardware = result.metrics.hardwareCounters.total;
+    double ipc = hardware.ipc();
+    long long branchMisses = hardware.get(HardwareEvent::BranchMisses);
+    long long llcMisses = hardware.get(HardwareEvent::LlcMisses);
+    stringstream ipcText;
+    ipcText << fixed << setprecision(2) << ipc;
+    cout << right << setw(8) << (ipc < 0 ? "-" : ipcText.str())
+         << right << setw(15) << (branchMisses < 0 ? "-" : to_string(branchMisses))
+         << right << setw(15) << (llcMisses < 0 ? "-" : to_string(llcMisses)) << endl;
+  }
+
+  for (const auto &result : results)
+  {
+    if (!result.metrics.hardwareCounters.available && !result.metrics.hardwareCounters.unavailableReason.empty())
+    {
+      cout << "Апаратні лічильники недоступні: " << result.metrics.hardwareCounters.unavailableReason << endl;
+      break;
+    }
   }
 
   cout << "\nВисновок:\n";
@@ -167,19 +225,19 @@ void compareSortResults(const vector<SortResult> &results)
     // Аналіз ефективності багатопотокового сортування
     for (size_t i = 0; i < results.size(); i++)
     {
-      if (results[i].name == "Багатопотоковий" && results[i].numThreads > 1)
+      if (results[i].name != "Послідовний" && results[i].numThreads > 1)
       {
-        // Знаходимо послідовний алгоритм для порівняння
+        // Знаходимо послідовний алгоритм (або той самий алгоритм на одному потоці) для порівняння
         for (size_t j = 0; j < results.size(); j++)
         {
           if (results[j].name == "Послідовний" ||
-              (results[j].name == "Багатопотоковий" && results[j].numThreads == 1))
+              (results[j].name == results[i].name && results[j].numThreads == 1))
           {
 
             double threadSpeedup = results[j].metrics.executionTimeMs / results[i].metrics.executionTimeMs;
             double efficiency = threadSpeedup / results[i].numThreads * 100;
 
-            cout << "- Ефективність багатопотокового сортування з "
+            cout << "- Ефективність сортування \"" << results[i].name << "\" з "
                  << results[i].numThreads << " потоками: "
                  << fixed << setprecision(2) << efficiency << "%\n";
 
@@ -211,4 +269,100 @@ bool getDetailedMode()
   return getYesNoInput("Увімкнути детальний режим виконання (показувати порівняння і обміни)?");
 }
 
+// Вибір рівня інструментування: детальний режим, часова шкала, лише лічильники або без вимірювань
+Instrumentation getInstrumentationMode()
+{
+  if (getDetailedMode())
+  {
+    return Instrumentation::Trace;
+  }
+
+  if (getYesNoInput("Записати часову шкалу потоків у файл Chrome trace (без виводу в консоль)?"))
+  {
+    return Instrumentation::Timeline;
+  }
+
+  if (getYesNoInput("Підраховувати порівняння та обміни (без підрахунку сортування швидше)?"))
+  {
+    return Instrumentation::Counters;
+  }
+
+  return Instrumentation::None;
+}
+
+// Seed генератора: введений користувачем або випадковий, якщо рядок порожній
+uint64_t getSeedInput()
+{
+  string seedInput = getStringInput("Введіть seed генератора (Enter - випадковий): ");
+  if (seedInput.empty())
+  {
+    return ArrayOperations::randomSeed();
+  }
+
+  size_t parsed = 0;
+  uint64_t seed = 0;
+  try
+  {
+    seed = stoull(seedInput, &parsed);
+  }
+  catch (const exception &)
+  {
+  }
+  if (parsed == 0 || parsed != seedInput.size())
+  {
+    throw runtime_error("Некоректний seed: " + seedInput);
+  }
+  return seed;
+}
+
+// Вибір форми масиву для генерації
+Distribution getDistributionMode()
+{
+  cout << "Виберіть розподіл:\n";
+  cout << "1. Рівномірний випадковий\n";
+  cout << "2. Відсортований\n";
+  cout << "3. Відсортований у зворотному порядку\n";
+  cout << "4. Майже відсортований (k випадкових обмінів)\n";
+  cout << "5. Пилка (повторювані зростаючі ділянки)\n";
+  cout << "6. Органна труба (зростання, потім спадання)\n";
+  cout << "7. Кілька унікальних значень\n";
+  cout << "8. Розподіл Ципфа (сильна асиметрія)\n";
+  cout << "9. Усі елементи однакові\n";
+  int choice = getIntInput("Ваш вибір: ");
+
+  if (choice < 1 || choice > ArrayGenerator::NUM_DISTRIBUTIONS)
+  {
+    throw runtime_error("Невірний вибір розподілу");
+  }
+  return static_cast<Distribution>(choice - 1);
+}
+
+// Додаткові параметри вибраного розподілу
+void getDistributionParams(Distribution distribution, DistributionParams &params)
+{
+  switch (distribution)
+  {
+  case Distribution::NearlySorted:
+    params.swaps = getIntInput("Введіть кількість випадкових обмінів: ");
+    break;
+  case Distribution::Sawtooth:
+    params.period = getIntInput("Введіть довжину одного зубця: ");
+    break;
+  case Distribution::FewUnique:
+    params.uniqueValues = getIntInput("Введіть кількість унікальних значень: ");
+    break;
+  case Distribution::Zipf:
+  {
+    string exponent = getStringInput("Введіть показник розподілу Ципфа (Enter - 1.0): ");
+    if (!exponent.empty())
+    {
+      params.zipfExponent = atof(exponent.c_str());
+    }
+    break;
+  }
+  default:
+    break;
+  }
+}
+
 #endif // MENU_FUNCTIONS_H
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include <cstdint>
+
+using namespace std;
+
+// Philox4x32-10 counter-based random number generator (Salmon et al.,
+// "Parallel Random Numbers: As Easy as 1, 2, 3", SC'11).
+// A block of four 32-bit words is a pure function of (counter, key), so any
+// part of the stream can be generated without generating what precedes it:
+// threads filling disjoint ranges produce exactly the serial output.
+struct PhiloxBlock
+{
+  uint32_t words[4];
+};
+
+class Philox
+{
+public:
+  static PhiloxBlock generate(uint64_t counter, uint64_t key)
+  {
+    uint32_t c0 = static_cast<uint32_t>(counter);
+    uint32_t c1 = static_cast<uint32_t>(counter >> 32);
+    uint32_t c2 = 0;
+    uint32_t c3 = 0;
+    uint32_t k0 = static_cast<uint32_t>(key);
+    uint32_t k1 = static_cast<uint32_t>(key >> 32);
+
+    for (int round = 0; round < ROUNDS; round++)
+    {
+      uint64_t product0 = static_cast<uint64_t>(MULTIPLIER0) * c0;
+      uint64_t product1 = static_cast<uint64_t>(MULTIPLIER1) * c2;
+
+      uint32_t next0 = static_cast<uint32_t>(product1 >> 32) ^ c1 ^ k0;
+      uint32_t next2 = static_cast<uint32_t>(product0 >> 32) ^ c3 ^ k1;
+      c1 = static_cast<uint32_t>(product1);
+      c3 = static_cast<uint32_t>(product0);
+      c0 = next0;
+      c2 = next2;
+
+      // Ключ змінюється між раундами на сталі Вейля
+      k0 += WEYL0;
+      k1 += WEYL1;
+    }
+
+    PhiloxBlock block = {{c0, c1, c2, c3}};
+    return block;
+  }
+
+private:
+  static const int ROUNDS = 10;
+  static const uint32_t MULTIPLIER0 = 0xD2511F53u;
+  static const uint32_t MULTIPLIER1 = 0xCD9E8D57u;
+  static const uint32_t WEYL0 = 0x9E3779B9u;
+  static const uint32_t WEYL1 = 0xBB67AE85u;
+};
+
+#endif // PHILOX_H
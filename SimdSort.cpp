@@ -0,0 +1,72 @@
+#include "SimdSort.h"
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef SIMD_SORT_X86
+// Реалізації в окремих файлах, скомпільованих з -mavx2 / -mavx512f
+void simdSortAvx2(int *data, int n, int *scratch);
+void simdSortAvx512(int *data, int n, int *scratch);
+#endif
+
+SimdIsa SimdSort::detectIsa()
+{
+#ifdef SIMD_SORT_X86
+  static const SimdIsa detected = []()
+  {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+      return SimdIsa::Avx512;
+    if (__builtin_cpu_supports("avx2"))
+      return SimdIsa::Avx2;
+    return SimdIsa::Scalar;
+  }();
+  return detected;
+#else
+  return SimdIsa::Scalar;
+#endif
+}
+
+string SimdSort::isaName(SimdIsa isa)
+{
+  switch (isa)
+  {
+  case SimdIsa::Avx512:
+    return "avx512";
+  case SimdIsa::Avx2:
+    return "avx2";
+  case SimdIsa::Scalar:
+    return "scalar";
+  }
+  return "unknown";
+}
+
+void SimdSort::sort(int *data, int n)
+{
+  sort(data, n, detectIsa());
+}
+
+void SimdSort::sort(int *data, int n, SimdIsa isa)
+{
+  if (n < 2)
+    return;
+
+  if (isa != SimdIsa::Scalar && static_cast<int>(isa) > static_cast<int>(detectIsa()))
+  {
+    throw runtime_error("Набір інструкцій " + isaName(isa) + " не підтримується процесором");
+  }
+
+#ifdef SIMD_SORT_X86
+  if (isa != SimdIsa::Scalar)
+  {
+    vector<int> scratch(n);
+    if (isa == SimdIsa::Avx512)
+      simdSortAvx512(data, n, scratch.data());
+    else
+      simdSortAvx2(data, n, scratch.data());
+    return;
+  }
+#endif
+
+  std::sort(data, data + n);
+}
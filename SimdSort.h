@@ -0,0 +1,36 @@
+#ifndef SIMD_SORT_H
+#define SIMD_SORT_H
+
+#include <string>
+
+using namespace std;
+
+// Instruction sets the SIMD sort kernel can run on
+enum class SimdIsa
+{
+  Scalar,
+  Avx2,
+  Avx512
+};
+
+// Vectorized sorting kernel for int arrays.
+// Sorts W-element blocks inside registers with min/max bitonic networks and
+// merges the runs with vectorized bitonic merges. The instruction set is
+// chosen once at runtime via CPUID; CPUs without AVX2 use a scalar path.
+class SimdSort
+{
+public:
+  // Best instruction set supported by this CPU and build
+  static SimdIsa detectIsa();
+
+  // Human-readable name ("avx512", "avx2", "scalar")
+  static string isaName(SimdIsa isa);
+
+  // Sort data[0, n) ascending with the best available kernel
+  static void sort(int *data, int n);
+
+  // Sort with an explicitly chosen kernel (must be supported by the CPU)
+  static void sort(int *data, int n, SimdIsa isa);
+};
+
+#endif // SIMD_SORT_H
@@ -0,0 +1,59 @@
+// Compiled with -mavx2; called only after a CPUID check (see SimdSort.cpp)
+#include <immintrin.h>
+#include "SimdSortImpl.h"
+
+namespace
+{
+  const BitonicTables<8> &avx2Tables()
+  {
+    // Ініціалізація при першому виклику, а не при старті програми: код цього файлу
+    // не можна виконувати до перевірки підтримки AVX2
+    static const BitonicTables<8> tables;
+    return tables;
+  }
+
+  struct Avx2Vec
+  {
+    typedef __m256i reg;
+    static const int W = 8;
+
+    static reg load(const int *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+    static void store(int *p, reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+
+    static reg stage(reg v, const int *perm, const int *maxMask)
+    {
+      reg other = _mm256_permutevar8x32_epi32(v, load(perm));
+      return _mm256_blendv_epi8(_mm256_min_epi32(v, other), _mm256_max_epi32(v, other), load(maxMask));
+    }
+
+    static reg sortRegister(reg v)
+    {
+      const BitonicTables<8> &t = avx2Tables();
+      for (int s = 0; s < t.sortStages; s++)
+      {
+        v = stage(v, t.sortPerm[s], t.sortMaxMask[s]);
+      }
+      return v;
+    }
+
+    static void mergeRegisters(reg &a, reg &b)
+    {
+      const BitonicTables<8> &t = avx2Tables();
+      reg reversed = _mm256_permutevar8x32_epi32(b, load(t.reverse));
+      reg low = _mm256_min_epi32(a, reversed);
+      reg high = _mm256_max_epi32(a, reversed);
+      for (int s = 0; s < t.mergeStages; s++)
+      {
+        low = stage(low, t.mergePerm[s], t.mergeMaxMask[s]);
+        high = stage(high, t.mergePerm[s], t.mergeMaxMask[s]);
+      }
+      a = low;
+      b = high;
+    }
+  };
+}
+
+void simdSortAvx2(int *data, int n, int *scratch)
+{
+  simdMergeSort<Avx2Vec>(data, n, scratch);
+}
@@ -0,0 +1,64 @@
+// Compiled with -mavx512f; called only after a CPUID check (see SimdSort.cpp)
+#include <immintrin.h>
+#include "SimdSortImpl.h"
+
+namespace
+{
+  const BitonicTables<16> &avx512Tables()
+  {
+    // Ініціалізація при першому виклику, а не при старті програми: код цього файлу
+    // не можна виконувати до перевірки підтримки AVX-512
+    static const BitonicTables<16> tables;
+    return tables;
+  }
+
+  __mmask16 toMask(const int *lanes)
+  {
+    return _mm512_cmpneq_epi32_mask(_mm512_loadu_si512(lanes), _mm512_setzero_si512());
+  }
+
+  struct Avx512Vec
+  {
+    typedef __m512i reg;
+    static const int W = 16;
+
+    static reg load(const int *p) { return _mm512_loadu_si512(p); }
+    static void store(int *p, reg v) { _mm512_storeu_si512(p, v); }
+
+    static reg stage(reg v, const int *perm, const int *maxMask)
+    {
+      reg other = _mm512_permutexvar_epi32(load(perm), v);
+      return _mm512_mask_blend_epi32(toMask(maxMask), _mm512_min_epi32(v, other), _mm512_max_epi32(v, other));
+    }
+
+    static reg sortRegister(reg v)
+    {
+      const BitonicTables<16> &t = avx512Tables();
+      for (int s = 0; s < t.sortStages; s++)
+      {
+        v = stage(v, t.sortPerm[s], t.sortMaxMask[s]);
+      }
+      return v;
+    }
+
+    static void mergeRegisters(reg &a, reg &b)
+    {
+      const BitonicTables<16> &t = avx512Tables();
+      reg reversed = _mm512_permutexvar_epi32(load(t.reverse), b);
+      reg low = _mm512_min_epi32(a, reversed);
+      reg high = _mm512_max_epi32(a, reversed);
+      for (int s = 0; s < t.mergeStages; s++)
+      {
+        low = stage(low, t.mergePerm[s], t.mergeMaxMask[s]);
+        high = stage(high, t.mergePerm[s], t.mergeMaxMask[s]);
+      }
+      a = low;
+      b = high;
+    }
+  };
+}
+
+void simdSortAvx512(int *data, int n, int *scratch)
+{
+  simdMergeSort<Avx512Vec>(data, n, scratch);
+}
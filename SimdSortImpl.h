@@ -0,0 +1,219 @@
+#ifndef SIMD_SORT_IMPL_H
+#define SIMD_SORT_IMPL_H
+
+// Generic SIMD merge sort, included only by the per-ISA translation units
+// (SimdSortAvx2.cpp, SimdSortAvx512.cpp) which are compiled with matching
+// -m flags. Everything lives in an anonymous namespace and uses no standard
+// library templates, so no ISA-specific code can leak into the rest of the
+// program through shared inline functions.
+//
+// Vec must provide:
+//   typedef reg; static const int W;
+//   static reg load(const int *); static void store(int *, reg);
+//   static reg sortRegister(reg);            // sort W lanes ascending
+//   static void mergeRegisters(reg &, reg &); // two sorted regs -> low half, high half
+
+namespace
+{
+  void insertionSort(int *data, int n)
+  {
+    for (int i = 1; i < n; i++)
+    {
+      int value = data[i];
+      int j = i - 1;
+      while (j >= 0 && data[j] > value)
+      {
+        data[j + 1] = data[j];
+        j--;
+      }
+      data[j + 1] = value;
+    }
+  }
+
+  // Скалярне злиття трьох відсортованих послідовностей (залишки векторного злиття)
+  void scalarMerge3(const int *a, int la, const int *b, int lb, const int *c, int lc, int *out)
+  {
+    int ia = 0, ib = 0, ic = 0;
+    while (ia < la || ib < lb || ic < lc)
+    {
+      // Рівні елементи беремо в порядку a, b, c
+      int source = -1;
+      int best = 0;
+      if (ia < la)
+      {
+        source = 0;
+        best = a[ia];
+      }
+      if (ib < lb && (source < 0 || b[ib] < best))
+      {
+        source = 1;
+        best = b[ib];
+      }
+      if (ic < lc && (source < 0 || c[ic] < best))
+      {
+        source = 2;
+        best = c[ic];
+      }
+
+      *out++ = best;
+      if (source == 0)
+        ia++;
+      else if (source == 1)
+        ib++;
+      else
+        ic++;
+    }
+  }
+
+  // Merge sorted runs A and B into out with W-wide bitonic merges.
+  // The next register is always loaded from the run with the smaller head,
+  // so every stored low half is <= all elements that are still pending.
+  template <typename Vec>
+  void mergeRuns(const int *A, int la, const int *B, int lb, int *out)
+  {
+    const int W = Vec::W;
+    if (la < W || lb < W)
+    {
+      scalarMerge3(A, la, B, lb, nullptr, 0, out);
+      return;
+    }
+
+    typename Vec::reg low = Vec::load(A);
+    typename Vec::reg high = Vec::load(B);
+    int ia = W, ib = W;
+
+    Vec::mergeRegisters(low, high);
+    Vec::store(out, low);
+    out += W;
+
+    while (true)
+    {
+      bool takeA;
+      if (ia < la && ib < lb)
+        takeA = A[ia] <= B[ib];
+      else if (ia < la)
+        takeA = true;
+      else if (ib < lb)
+        takeA = false;
+      else
+        break;
+
+      if (takeA)
+      {
+        if (la - ia < W)
+          break;
+        low = Vec::load(A + ia);
+        ia += W;
+      }
+      else
+      {
+        if (lb - ib < W)
+          break;
+        low = Vec::load(B + ib);
+        ib += W;
+      }
+
+      Vec::mergeRegisters(low, high);
+      Vec::store(out, low);
+      out += W;
+    }
+
+    int rest[Vec::W];
+    Vec::store(rest, high);
+    scalarMerge3(rest, W, A + ia, la - ia, B + ib, lb - ib, out);
+  }
+
+  // Sort data[0, n) using scratch[0, n) as the second merge buffer
+  template <typename Vec>
+  void simdMergeSort(int *data, int n, int *scratch)
+  {
+    const int W = Vec::W;
+
+    // 1. Сортування блоків по W елементів усередині регістра
+    int full = n - n % W;
+    for (int i = 0; i < full; i += W)
+    {
+      Vec::store(data + i, Vec::sortRegister(Vec::load(data + i)));
+    }
+    insertionSort(data + full, n - full);
+
+    // 2. Висхідне злиття серій, буфери міняються ролями після кожного проходу
+    int *src = data;
+    int *dst = scratch;
+    for (long long width = W; width < n; width *= 2)
+    {
+      for (long long lo = 0; lo < n; lo += 2 * width)
+      {
+        int mid = static_cast<int>(lo + width < n ? lo + width : n);
+        int hi = static_cast<int>(lo + 2 * width < n ? lo + 2 * width : n);
+        mergeRuns<Vec>(src + lo, mid - static_cast<int>(lo), src + mid, hi - mid, dst + lo);
+      }
+
+      int *t = src;
+      src = dst;
+      dst = t;
+    }
+
+    if (src != data)
+    {
+      for (int i = 0; i < n; i++)
+      {
+        data[i] = src[i];
+      }
+    }
+  }
+
+  // Permutation indices and "take max" lane masks of the bitonic network stages
+  template <int W>
+  struct BitonicTables
+  {
+    static const int MAX_STAGES = 16;
+
+    int sortStages;
+    int sortPerm[MAX_STAGES][W];
+    int sortMaxMask[MAX_STAGES][W];
+
+    int mergeStages;
+    int mergePerm[MAX_STAGES][W];
+    int mergeMaxMask[MAX_STAGES][W];
+
+    int reverse[W];
+
+    BitonicTables() : sortStages(0), mergeStages(0)
+    {
+      // Повне бітонічне сортування одного регістра
+      for (int k = 2; k <= W; k *= 2)
+      {
+        for (int j = k / 2; j >= 1; j /= 2)
+        {
+          for (int i = 0; i < W; i++)
+          {
+            bool lower = (i & j) == 0;
+            bool ascending = (i & k) == 0;
+            sortPerm[sortStages][i] = i ^ j;
+            sortMaxMask[sortStages][i] = lower == ascending ? 0 : -1;
+          }
+          sortStages++;
+        }
+      }
+
+      // Очищення бітонічної послідовності після обміну між двома регістрами
+      for (int j = W / 2; j >= 1; j /= 2)
+      {
+        for (int i = 0; i < W; i++)
+        {
+          mergePerm[mergeStages][i] = i ^ j;
+          mergeMaxMask[mergeStages][i] = (i & j) ? -1 : 0;
+        }
+        mergeStages++;
+      }
+
+      for (int i = 0; i < W; i++)
+      {
+        reverse[i] = W - 1 - i;
+      }
+    }
+  };
+}
+
+#endif // SIMD_SORT_IMPL_H
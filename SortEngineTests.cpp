@@ -0,0 +1,1014 @@
+// Перевірки рушіїв сортування на типах і порядках, яких не використовують
+// меню, пакетний режим і бенчмарк. Результат кожного рушія порівнюється з
+// std::sort / std::stable_sort; програма повертає 1, якщо хоч одна перевірка не пройшла.
+
+#include "ArrayOperations.h"
+#include "ExternalSort.h"
+#include "SortPlanner.h"
+#include "SpinBarrier.h"
+#include <iostream>
+#include <sstream>
+#include <functional>
+#include <random>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <climits>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+namespace
+{
+  int failures = 0;
+  int checks = 0;
+
+  void check(bool condition, const string &what)
+  {
+    checks++;
+    if (!condition)
+    {
+      failures++;
+      cerr << "ПОМИЛКА: " << what << endl;
+    }
+  }
+
+  // Рушії друкують хід сортування; у тестах цей вивід не потрібен
+  class SilentOutput
+  {
+  public:
+    SilentOutput() : saved(cout.rdbuf(sink.rdbuf())) {}
+    ~SilentOutput() { cout.rdbuf(saved); }
+
+  private:
+    ostringstream sink;
+    streambuf *saved;
+  };
+
+  typedef Record<int64_t, int64_t> TimestampRecord;
+
+  // Однакові біти, щоб відрізняти -0.0 від 0.0 і порівнювати NaN
+  template <typename T>
+  bool sameElements(const vector<T> &a, const vector<T> &b)
+  {
+    return a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+  }
+
+  bool sameElements(const vector<TimestampRecord> &a, const vector<TimestampRecord> &b)
+  {
+    if (a.size() != b.size())
+      return false;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+      if (a[i].key != b[i].key || a[i].payload != b[i].payload)
+        return false;
+    }
+    return true;
+  }
+
+  template <typename T>
+  vector<T> randomValues(size_t n, mt19937_64 &rng)
+  {
+    vector<T> values(n);
+    if (is_floating_point<T>::value)
+    {
+      uniform_real_distribution<double> value(-1e6, 1e6);
+      for (auto &v : values)
+        v = static_cast<T>(value(rng));
+    }
+    else
+    {
+      // Повний діапазон типу, з повторами в малій частині масиву
+      uniform_int_distribution<long long> value(numeric_limits<T>::min(), numeric_limits<T>::max());
+      for (size_t i = 0; i < n; i++)
+        values[i] = i % 4 == 3 && i > 0 ? values[i / 2] : static_cast<T>(value(rng));
+    }
+    return values;
+  }
+
+  // Дійсні значення з NaN, нескінченностями і нулями обох знаків
+  template <typename T>
+  vector<T> specialValues(size_t n, mt19937_64 &rng)
+  {
+    const T specials[] = {numeric_limits<T>::quiet_NaN(), numeric_limits<T>::infinity(), -numeric_limits<T>::infinity(),
+                          T(0.0), T(-0.0), numeric_limits<T>::lowest(), numeric_limits<T>::denorm_min()};
+    vector<T> values = randomValues<T>(n, rng);
+    uniform_int_distribution<int> pick(0, 2 * static_cast<int>(sizeof(specials) / sizeof(specials[0])) - 1);
+    for (auto &v : values)
+    {
+      int k = pick(rng);
+      if (k < static_cast<int>(sizeof(specials) / sizeof(specials[0])))
+        v = specials[k];
+    }
+    return values;
+  }
+
+  // Записи з багатьма однаковими ключами; payload - початкова позиція
+  vector<TimestampRecord> randomRecords(size_t n, mt19937_64 &rng)
+  {
+    uniform_int_distribution<int64_t> key(-20, 20);
+    vector<TimestampRecord> records(n);
+    for (size_t i = 0; i < n; i++)
+    {
+      records[i].key = key(rng) * 1000000007LL;
+      records[i].payload = static_cast<int64_t>(i);
+    }
+    return records;
+  }
+
+  template <typename T, typename Less>
+  struct NamedEngine
+  {
+    string name;
+    bool stable;
+    function<SortMetrics(vector<T> &)> sort;
+  };
+
+  // Усі рушії, скомпільовані для довільного типу і порядку
+  template <typename T, typename Less>
+  vector<NamedEngine<T, Less>> genericEngines(const Less &less)
+  {
+    typedef ArrayOperations Ops;
+    return {
+        {"bubble", true, [less](vector<T> &a) { return Ops::bubbleSort(a, Instrumentation::None, FastPath::Disabled, less); }},
+        {"bubble-counters", true, [less](vector<T> &a) { return Ops::bubbleSort(a, Instrumentation::Counters, FastPath::Auto, less); }},
+        {"early-exit", true, [less](vector<T> &a) { return Ops::adaptiveBubbleSort(a, BubbleVariant::EarlyExit, Instrumentation::None, less); }},
+        {"cocktail", true, [less](vector<T> &a) { return Ops::adaptiveBubbleSort(a, BubbleVariant::CocktailShaker, Instrumentation::Counters, less); }},
+        {"comb", false, [less](vector<T> &a) { return Ops::adaptiveBubbleSort(a, BubbleVariant::Comb, Instrumentation::None, less); }},
+        {"multithreaded", true, [less](vector<T> &a) { return Ops::bubbleSortMultithreaded(a, 3, Instrumentation::Counters, SegmentKernel::Bubble, FastPath::Disabled, less); }},
+        {"multithreaded-simd", true, [less](vector<T> &a) { return Ops::bubbleSortMultithreaded(a, 2, Instrumentation::None, SegmentKernel::Simd, FastPath::Auto, less); }},
+        {"odd-even", true, [less](vector<T> &a) { return Ops::oddEvenSortMultithreaded(a, 3, Instrumentation::Counters, less); }},
+    };
+  }
+
+  // Кожен рушій на кожному вході дає той самий результат, що й std::stable_sort;
+  // для нестабільних рушіїв порівнюються лише ключі
+  template <typename T, typename Less, typename Key>
+  void checkEngines(const string &typeName, const vector<vector<T>> &inputs, const Less &less, Key keyOf)
+  {
+    for (const auto &engine : genericEngines<T, Less>(less))
+    {
+      for (const auto &input : inputs)
+      {
+        vector<T> expected = input;
+        stable_sort(expected.begin(), expected.end(), less);
+
+        vector<T> actual = input;
+        {
+          SilentOutput silent;
+          engine.sort(actual);
+        }
+
+        string what = typeName + " " + engine.name + ", n = " + to_string(input.size());
+        check(ArrayOperations::isSorted(actual, less), what + ": результат не відсортований");
+        if (engine.stable)
+        {
+          check(sameElements(actual, expected), what + ": результат відрізняється від std::stable_sort");
+        }
+        else
+        {
+          bool sameKeys = actual.size() == expected.size();
+          for (size_t i = 0; sameKeys && i < actual.size(); i++)
+            sameKeys = !less(keyOf(actual[i]), keyOf(expected[i])) && !less(keyOf(expected[i]), keyOf(actual[i]));
+          check(sameKeys, what + ": ключі відрізняються від std::stable_sort");
+        }
+      }
+    }
+  }
+
+  template <typename T>
+  T identity(const T &value) { return value; }
+
+  template <typename T>
+  void testNumericEngines(const string &typeName, mt19937_64 &rng)
+  {
+    vector<vector<T>> inputs;
+    for (size_t n : {0, 1, 2, 3, 17, 300, 1500})
+    {
+      inputs.push_back(randomValues<T>(n, rng));
+    }
+    inputs.push_back(vector<T>(500, T(7)));
+
+    vector<T> descending = randomValues<T>(800, rng);
+    sort(descending.rbegin(), descending.rend());
+    inputs.push_back(descending);
+
+    if (is_floating_point<T>::value)
+    {
+      for (size_t n : {5, 64, 1200})
+      {
+        inputs.push_back(specialValues<T>(n, rng));
+      }
+    }
+
+    checkEngines(typeName, inputs, NaturalOrder<T>(), identity<T>);
+  }
+
+  // NaN більший за всі числа, тому після сортування стоїть у кінці; -0.0 і 0.0 рівні
+  template <typename T>
+  void testFloatingOrder(const string &typeName)
+  {
+    const T nan = numeric_limits<T>::quiet_NaN();
+    NaturalOrder<T> less;
+    check(less(T(1), nan) && !less(nan, T(1)) && !less(nan, nan), typeName + ": NaN має бути більшим за числа і рівним NaN");
+    check(!less(T(-0.0), T(0.0)) && !less(T(0.0), T(-0.0)), typeName + ": -0.0 і 0.0 мають бути рівними");
+
+    check(ArrayOperations::isSorted(vector<T>{T(-1), T(0), T(2), nan, nan}), typeName + ": NaN у кінці - відсортований масив");
+    check(!ArrayOperations::isSorted(vector<T>{T(1), nan, T(2)}), typeName + ": NaN перед числом - невідсортований масив");
+    check(ArrayOperations::isSorted(vector<T>{T(0.0), T(-0.0), T(0.0)}), typeName + ": нулі різних знаків - відсортований масив");
+
+    vector<T> values = {nan, T(3), T(0.0), -numeric_limits<T>::infinity(), nan, T(-0.0), T(-2), numeric_limits<T>::infinity()};
+    {
+      SilentOutput silent;
+      ArrayOperations::bubbleSort(values, Instrumentation::None);
+    }
+    check(values[0] == -numeric_limits<T>::infinity() && values[1] == T(-2) && values[4] == T(3) &&
+              values[5] == numeric_limits<T>::infinity() && std::isnan(values[6]) && std::isnan(values[7]),
+          typeName + ": порядок нескінченностей, чисел і NaN");
+    // Стабільне сортування зберігає початковий порядок рівних нулів
+    check(!signbit(values[2]) && signbit(values[3]), typeName + ": 0.0 і -0.0 мають зберегти початковий порядок");
+  }
+
+  void testRecords(mt19937_64 &rng)
+  {
+    vector<vector<TimestampRecord>> inputs;
+    for (size_t n : {0, 1, 2, 40, 700, 2000})
+    {
+      inputs.push_back(randomRecords(n, rng));
+    }
+
+    KeyOrder<RecordKey> byKey;
+    checkEngines("Record<int64,int64>", inputs, byKey, [](const TimestampRecord &r) { return r; });
+
+    // Корисне навантаження переміщується разом з ключем
+    vector<TimestampRecord> records = randomRecords(500, rng);
+    vector<TimestampRecord> original = records;
+    {
+      SilentOutput silent;
+      ArrayOperations::adaptiveBubbleSort(records, BubbleVariant::Comb, Instrumentation::None, byKey);
+    }
+    bool payloadsFollow = true;
+    vector<bool> seen(original.size(), false);
+    for (const auto &record : records)
+    {
+      payloadsFollow = payloadsFollow && record.payload >= 0 && record.payload < static_cast<int64_t>(original.size()) &&
+                       !seen[record.payload] && original[record.payload].key == record.key;
+      if (payloadsFollow)
+        seen[record.payload] = true;
+    }
+    check(payloadsFollow, "Record comb: кожен запис має зберегти свій payload");
+  }
+
+  // Потокове читання і запис файлу частинами для типу T в обох форматах
+  template <typename T>
+  void testFileStreaming(const string &typeName, mt19937_64 &rng)
+  {
+    vector<T> values = randomValues<T>(10007, rng);
+    string filename = "sort_engine_tests_" + typeName + ".tmp";
+
+    for (ArrayFileFormat format : {ArrayFileFormat::Text, ArrayFileFormat::Binary})
+    {
+      string what = typeName + (format == ArrayFileFormat::Binary ? " binary" : " text");
+      {
+        ArrayFileWriter<T> writer(filename, format, values.size());
+        for (size_t i = 0; i < values.size(); i += 1000)
+        {
+          writer.write(values.data() + i, min<size_t>(1000, values.size() - i));
+        }
+        writer.finish();
+      }
+
+      vector<T> loaded;
+      ArrayFileReader<T> reader(filename);
+      check(reader.getFormat() == format && reader.size() == values.size(), what + ": заголовок файлу");
+      vector<T> chunk;
+      while (reader.read(chunk, 777) > 0)
+      {
+        loaded.insert(loaded.end(), chunk.begin(), chunk.end());
+      }
+      check(sameElements(loaded, values), what + ": прочитані частинами значення відрізняються від записаних");
+
+      vector<T> whole = ArrayOperations::loadArrayFromFile<T>(filename);
+      check(sameElements(whole, values), what + ": значення, прочитані цілим масивом, відрізняються від записаних");
+    }
+
+    // Бінарний файл читається лише як тип, яким його записано
+    bool rejected = false;
+    try
+    {
+      ArrayFileReader<typename conditional<sizeof(T) == 8, int32_t, int64_t>::type> wrongType(filename);
+    }
+    catch (const runtime_error &)
+    {
+      rejected = true;
+    }
+    check(rejected, typeName + ": бінарний файл іншого типу має бути відхилено");
+
+    remove(filename.c_str());
+  }
+
+  // Порозрядне сортування на входах, що перевіряють знак, пропуск цифр і кількість проходів
+  template <typename T>
+  void testRadixSort(const string &typeName, mt19937_64 &rng)
+  {
+    const T lowest = numeric_limits<T>::min();
+    const T highest = numeric_limits<T>::max();
+
+    vector<vector<T>> inputs = {{}, {T(5)}, {highest, lowest}, {T(-1), T(0), lowest, highest, T(1), T(-2), lowest}};
+    for (size_t n : {2, 999, 4003, 20000})
+    {
+      inputs.push_back(randomValues<T>(n, rng));
+    }
+
+    // Від'ємні і додатні числа з різними старшими цифрами
+    uniform_int_distribution<long long> small(-300, 300);
+    vector<T> mixed(5000);
+    for (size_t i = 0; i < mixed.size(); i++)
+    {
+      mixed[i] = i % 97 == 0 ? (i % 2 ? lowest : highest) : static_cast<T>(small(rng) * (i % 3 ? 1 : 1000003));
+    }
+    inputs.push_back(mixed);
+
+    for (const auto &input : inputs)
+    {
+      vector<T> expected = input;
+      sort(expected.begin(), expected.end());
+
+      for (int threads : {1, 2, 4})
+      {
+        vector<T> actual = input;
+        {
+          SilentOutput silent;
+          ArrayOperations::radixSort(actual, threads, Instrumentation::None);
+        }
+        check(actual == expected, typeName + " radix, n = " + to_string(input.size()) + ", потоків " + to_string(threads) +
+                                      ": результат відрізняється від std::sort");
+      }
+    }
+
+    // Кількість проходів: лише цифри, що відрізняються хоч в одного елемента
+    SortMetrics probe;
+    vector<T> sample = {T(1), T(0)};
+    {
+      SilentOutput silent;
+      probe = ArrayOperations::radixSort(sample, 1, Instrumentation::None);
+    }
+    int digitBits = stoi(probe.additionalInfo.at("radixDigitBits"));
+    int numDigits = static_cast<int>(sizeof(T)) * 8 / digitBits;
+
+    struct PassCase
+    {
+      string name;
+      vector<T> values;
+      int passes;
+    };
+    vector<T> lowDigit(3000);
+    vector<T> twoDigits(3000);
+    for (size_t i = 0; i < lowDigit.size(); i++)
+    {
+      lowDigit[i] = static_cast<T>((lowDigit.size() - i) % (T(1) << digitBits));
+      twoDigits[i] = static_cast<T>((i * 7919) % (T(1) << (2 * digitBits)));
+    }
+    vector<PassCase> cases = {
+        {"однакові", vector<T>(3000, T(-42)), 0},
+        {"одна цифра", lowDigit, 1},
+        {"дві цифри", twoDigits, 2},
+        {"-1 і 0", {T(-1), T(0), T(-1), T(0)}, numDigits},
+    };
+    for (const auto &c : cases)
+    {
+      for (int threads : {1, 3})
+      {
+        vector<T> actual = c.values;
+        vector<T> expected = c.values;
+        sort(expected.begin(), expected.end());
+        SortMetrics metrics;
+        {
+          SilentOutput silent;
+          metrics = ArrayOperations::radixSort(actual, threads, Instrumentation::Counters);
+        }
+        string what = typeName + " radix, " + c.name + ", потоків " + to_string(threads);
+        check(actual == expected, what + ": результат відрізняється від std::sort");
+        check(metrics.additionalInfo.at("radixPasses") == to_string(c.passes), what + ": очікувалось проходів " + to_string(c.passes) +
+                                                                                     ", виконано " + metrics.additionalInfo.at("radixPasses"));
+      }
+    }
+  }
+
+  // Сортування підрахунком вмикається рівно до меж діапазону і розміру масиву
+  template <typename T>
+  void testCountingFastPath(const string &typeName, mt19937_64 &rng)
+  {
+    const long long MAX_RANGE = ArrayOperations::COUNTING_SORT_MAX_RANGE;
+
+    ValueRange range;
+    check(!ArrayOperations::isNarrowRange(range, 100), "порожній діапазон не сортується підрахунком");
+    range.empty = false;
+    range.minValue = -7;
+    range.maxValue = range.minValue + MAX_RANGE - 1;
+    check(ArrayOperations::isNarrowRange(range, MAX_RANGE), "діапазон COUNTING_SORT_MAX_RANGE - 1 - вузький");
+    range.maxValue++;
+    check(!ArrayOperations::isNarrowRange(range, 1 << 30), "діапазон COUNTING_SORT_MAX_RANGE - не вузький");
+    range.maxValue = range.minValue + 1000;
+    check(ArrayOperations::isNarrowRange(range, 1001) && !ArrayOperations::isNarrowRange(range, 1000),
+          "діапазон має бути меншим за розмір масиву");
+
+    // Масив значень з [base, base + span] з обома крайніми значеннями
+    auto spanArray = [&](long long base, long long span, size_t n)
+    {
+      uniform_int_distribution<long long> offset(0, span);
+      vector<T> values(n);
+      for (auto &v : values)
+        v = static_cast<T>(base + offset(rng));
+      values[n / 3] = static_cast<T>(base);
+      values[n / 2] = static_cast<T>(base + span);
+      return values;
+    };
+
+    struct PathCase
+    {
+      string name;
+      vector<T> values;
+      bool counted;
+    };
+    const long long lowest = numeric_limits<T>::min();
+    const long long highest = numeric_limits<T>::max();
+    vector<PathCase> cases = {
+        {"span = MAX_RANGE - 1", spanArray(-12345, MAX_RANGE - 1, MAX_RANGE + 5000), true},
+        {"span = MAX_RANGE", spanArray(-12345, MAX_RANGE, MAX_RANGE + 5000), false},
+        {"span = n - 1", spanArray(100, 2999, 3000), true},
+        {"span = n", spanArray(100, 3000, 3000), false},
+        {"від мінімуму типу", spanArray(lowest, 40000, 70000), true},
+        {"до максимуму типу", spanArray(highest - 40000, 40000, 70000), true},
+        {"один елемент", {T(3)}, true},
+    };
+
+    for (const auto &c : cases)
+    {
+      vector<T> expected = c.values;
+      sort(expected.begin(), expected.end());
+      string expectedPath = c.counted ? "counting" : "segment-merge";
+
+      // Квадратичний послідовний рушій - лише на малих масивах
+      if (c.counted || c.values.size() <= 5000)
+      {
+        vector<T> actual = c.values;
+        SortMetrics metrics;
+        {
+          SilentOutput silent;
+          metrics = ArrayOperations::bubbleSort(actual, Instrumentation::None);
+        }
+        string what = typeName + " bubble, " + c.name;
+        check(actual == expected, what + ": результат відрізняється від std::sort");
+        check(metrics.additionalInfo.at("sortPath") == (c.counted ? "counting" : "bubble"), what + ": шлях " + metrics.additionalInfo.at("sortPath"));
+      }
+
+      // SIMD-ядро сегментів є лише для int, інші типи без підрахунку сортуються бульбашкою
+      if (!c.counted && c.values.size() > 5000 && !is_same<T, int>::value)
+        continue;
+
+      for (int threads : {1, 2, 3, 4})
+      {
+        vector<T> actual = c.values;
+        SortMetrics metrics;
+        {
+          SilentOutput silent;
+          metrics = ArrayOperations::bubbleSortMultithreaded(actual, threads, Instrumentation::Counters, SegmentKernel::Simd);
+        }
+        string what = typeName + " multithreaded, " + c.name + ", потоків " + to_string(threads);
+        check(actual == expected, what + ": результат відрізняється від std::sort");
+        check(metrics.additionalInfo.at("sortPath") == expectedPath, what + ": шлях " + metrics.additionalInfo.at("sortPath"));
+      }
+    }
+
+    // Без швидкого шляху рушій завжди сортує власним алгоритмом
+    vector<T> values = spanArray(0, 10, 2000);
+    SortMetrics metrics;
+    {
+      SilentOutput silent;
+      metrics = ArrayOperations::bubbleSort(values, Instrumentation::None, FastPath::Disabled);
+    }
+    check(metrics.additionalInfo.at("sortPath") == "bubble" && ArrayOperations::isSorted(values),
+          typeName + " bubble: FastPath::Disabled не має сортувати підрахунком");
+  }
+
+  // Перше порушення порядку знаходиться точно на межах блоків і частин потоків
+  void testFindFirstUnsorted()
+  {
+    const size_t BLOCK = ArrayOperations::SCAN_BLOCK;
+    const int THREADS = 4;
+    const size_t n = THREADS * static_cast<size_t>(ArrayOperations::MIN_SCAN_CHUNK) + 12345;
+
+    vector<int> sorted(n);
+    for (size_t i = 0; i < n; i++)
+      sorted[i] = static_cast<int>(2 * i) - 1000000;
+
+    // Позиції біля меж блоків і частин потоків (поділ n * t / threads, як у findFirstUnsorted)
+    vector<size_t> positions = {1, 2, BLOCK - 1, BLOCK, BLOCK + 1, 2 * BLOCK, n - 1};
+    for (int threads = 2; threads <= THREADS; threads++)
+    {
+      for (int t = 1; t < threads; t++)
+      {
+        size_t boundary = n * t / threads;
+        for (size_t p : {boundary - 1, boundary, boundary + 1, boundary + BLOCK})
+          positions.push_back(p);
+      }
+    }
+
+    for (int threads : {0, 1, 2, 3, THREADS})
+    {
+      string suffix = ", потоків " + to_string(threads);
+      check(ArrayOperations::findFirstUnsorted(sorted, NaturalOrder<int>(), threads) == n, "відсортований масив" + suffix);
+
+      for (size_t p : positions)
+      {
+        vector<int> values = sorted;
+        values[p] = values[p - 1] - 1;
+        check(ArrayOperations::findFirstUnsorted(values, NaturalOrder<int>(), threads) == p,
+              "порушення на позиції " + to_string(p) + suffix);
+
+        // Пізніше порушення в іншій частині не заважає знайти перше
+        values[n - 1] = values[0] - 1;
+        values[n / 2 + 7] = values[0] - 1;
+        size_t expected = min(p, n / 2 + 7);
+        check(ArrayOperations::findFirstUnsorted(values, NaturalOrder<int>(), threads) == expected,
+              "кілька порушень, перше на позиції " + to_string(expected) + suffix);
+      }
+    }
+
+    // NaN більший за числа: число після NaN - порушення
+    vector<double> doubles(n);
+    for (size_t i = 0; i < n; i++)
+      doubles[i] = static_cast<double>(i);
+    size_t nanAt = n / THREADS - 1;
+    doubles[nanAt] = numeric_limits<double>::quiet_NaN();
+    check(ArrayOperations::findFirstUnsorted(doubles, NaturalOrder<double>(), THREADS) == nanAt + 1, "число після NaN");
+    check(ArrayOperations::findFirstUnsorted(vector<double>{1.0}) == 1 && ArrayOperations::findFirstUnsorted(vector<double>()) == 0,
+          "масиви з 0 і 1 елемента відсортовані");
+  }
+
+  // Статистика одного сканування збігається з послідовним підрахунком
+  void testScanArray(mt19937_64 &rng)
+  {
+    const size_t n = 3 * static_cast<size_t>(ArrayOperations::MIN_SCAN_CHUNK) + 999;
+    uniform_int_distribution<int> value(-5000, 5000);
+
+    vector<vector<int>> inputs;
+    vector<int> runs(n);
+    for (auto &v : runs)
+      v = value(rng);
+    inputs.push_back(runs);
+    sort(runs.begin(), runs.end());
+    inputs.push_back(runs);
+    // Серії, що перетинають межі частин потоків
+    for (size_t i = 0; i < n; i++)
+      runs[i] = static_cast<int>(i % (n / 3 + 17));
+    inputs.push_back(runs);
+
+    for (const auto &input : inputs)
+    {
+      size_t firstUnsorted = n;
+      size_t runCount = 1;
+      long long sum = input[0];
+      for (size_t i = 1; i < n; i++)
+      {
+        if (input[i] < input[i - 1])
+        {
+          firstUnsorted = min(firstUnsorted, i);
+          runCount++;
+        }
+        sum += input[i];
+      }
+      vector<int> distinct = input;
+      sort(distinct.begin(), distinct.end());
+      size_t distinctCount = unique(distinct.begin(), distinct.end()) - distinct.begin();
+
+      for (int threads : {1, 2, 3})
+      {
+        ArrayStatistics<int> stats = ArrayOperations::scanArray(input, threads);
+        string what = "scanArray, серій " + to_string(runCount) + ", потоків " + to_string(threads);
+        check(stats.size == n && stats.sorted == (firstUnsorted == n) && stats.firstUnsortedIndex == firstUnsorted, what + ": порушення порядку");
+        check(stats.runCount == runCount, what + ": кількість серій " + to_string(stats.runCount));
+        check(stats.minValue == distinct.front() && stats.maxValue == distinct[distinctCount - 1] && stats.sum == sum, what + ": мінімум, максимум, сума");
+        check(fabs(stats.distinctEstimate - distinctCount) < 0.05 * distinctCount, what + ": оцінка різних значень " + to_string(stats.distinctEstimate));
+      }
+    }
+
+    ArrayStatistics<int> empty = ArrayOperations::scanArray(vector<int>());
+    check(empty.size == 0 && empty.sorted && empty.runCount == 0, "scanArray порожнього масиву");
+  }
+
+  // Один seed дає однаковий масив для будь-якої кількості потоків генерації
+  void testGeneratorDeterminism()
+  {
+    const int THREADS = 4;
+    const int size = THREADS * ArrayGenerator::MIN_GENERATE_CHUNK + 4321;
+    const uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+    DistributionParams params;
+    params.minValue = -1000000;
+    params.maxValue = 1000000;
+    params.swaps = 1000;
+    params.period = 5000;
+    params.uniqueValues = 17;
+    params.zipfExponent = 1.2;
+
+    for (int d = 0; d < ArrayGenerator::NUM_DISTRIBUTIONS; d++)
+    {
+      Distribution distribution = static_cast<Distribution>(d);
+      string name = ArrayGenerator::distributionName(distribution);
+      vector<int> single = ArrayOperations::generateArray(size, distribution, params, seed, 1);
+      check(single.size() == static_cast<size_t>(size), name + ": розмір згенерованого масиву");
+
+      for (int threads : {2, 3, THREADS, 0})
+      {
+        vector<int> parallel = ArrayOperations::generateArray(size, distribution, params, seed, threads);
+        check(sameElements(parallel, single), name + ": масив на " + to_string(threads) + " потоках відрізняється від однопотокового");
+      }
+
+      bool seedMatters = distribution != Distribution::Sawtooth && distribution != Distribution::OrganPipe && distribution != Distribution::AllEqual;
+      if (seedMatters)
+      {
+        check(ArrayOperations::generateArray(size, distribution, params, seed + 1, THREADS) != single, name + ": інший seed має дати інший масив");
+      }
+    }
+  }
+
+  string readWholeFile(const string &filename)
+  {
+    ifstream file(filename, ios::binary);
+    ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+  }
+
+  // Паралельний запис тексту дає ті самі байти, що й колишній послідовний "file << value << ' '"
+  void testTextWriter(mt19937_64 &rng)
+  {
+    // Кілька пакетів частин на кількох потоках, остання частина неповна
+    ThreadPool::instance().ensureWorkers(3);
+    const size_t chunk = ArrayFileIO::FORMAT_CHUNK_ELEMENTS;
+    const string filename = "sort_engine_tests_text_writer.tmp";
+
+    vector<vector<int>> inputs = {{0}, {-1, 1, INT_MIN, INT_MAX, -10, 10, 0}, randomValues<int>(7 * chunk + 321, rng)};
+    vector<int> &large = inputs.back();
+    large[0] = INT_MIN;
+    large[chunk - 1] = INT_MAX;
+    large[chunk] = INT_MIN;
+    large.back() = -1;
+
+    for (const auto &values : inputs)
+    {
+      ostringstream reference;
+      reference << values.size() << endl;
+      for (int value : values)
+        reference << value << " ";
+
+      ArrayFileIO::saveText(values, filename);
+      check(readWholeFile(filename) == reference.str(), "текстовий запис " + to_string(values.size()) + " елементів відрізняється від потокового виводу");
+    }
+
+    remove(filename.c_str());
+  }
+
+  // Номер елемента з повідомлення "Помилка читання елементу #i", -1 - інша помилка або її немає
+  long long loadErrorIndex(const string &filename)
+  {
+    try
+    {
+      ArrayFileIO::loadText<int>(filename);
+    }
+    catch (const runtime_error &e)
+    {
+      string message = e.what();
+      const string prefix = "Помилка читання елементу #";
+      if (message.compare(0, prefix.size(), prefix) == 0)
+        return stoll(message.substr(prefix.size()));
+    }
+    return -1;
+  }
+
+  // Некоректне число в будь-якій частині паралельного розбору повідомляється з тим самим номером, що й при послідовному читанні
+  void testTextParseErrors(mt19937_64 &rng)
+  {
+    ThreadPool::instance().ensureWorkers(3);
+    const string filename = "sort_engine_tests_text_reader.tmp";
+
+    vector<int> values = randomValues<int>(ArrayFileIO::MIN_PARSE_CHUNK_BYTES / 2, rng);
+    ostringstream out;
+    out << values.size() << endl;
+    size_t bodyStart = out.str().size() - 1; // Розбір частин починається одразу після числа в заголовку
+    vector<size_t> tokenStarts;
+    for (int value : values)
+    {
+      tokenStarts.push_back(out.tellp());
+      out << value << " ";
+    }
+    const string text = out.str();
+
+    // Межі частин так само, як у loadText: рівні шматки тексту, зсунуті до пробілу
+    size_t bodyBytes = text.size() - bodyStart;
+    size_t numChunks = min<size_t>(max<size_t>(1, bodyBytes / ArrayFileIO::MIN_PARSE_CHUNK_BYTES), ThreadPool::instance().size());
+    check(numChunks >= 3, "текстовий файл має розбиратися щонайменше трьома частинами");
+
+    vector<long long> chunkFirst; // Номер першого елемента кожної частини, крім нульової
+    for (size_t i = 1; i < numChunks; i++)
+    {
+      size_t bound = bodyStart + bodyBytes * i / numChunks;
+      while (bound < text.size() && text[bound] != ' ' && text[bound] != '\n')
+        bound++;
+      chunkFirst.push_back(lower_bound(tokenStarts.begin(), tokenStarts.end(), bound) - tokenStarts.begin());
+    }
+
+    // Зіпсовані числа тієї самої довжини не зсувають межі частин
+    auto writeBroken = [&](const vector<long long> &broken)
+    {
+      string damaged = text;
+      for (long long index : broken)
+        damaged[tokenStarts[index]] = 'x';
+      ofstream file(filename, ios::binary);
+      file << damaged;
+    };
+
+    for (long long first : chunkFirst)
+    {
+      for (long long index : {first - 1, first, first + 1})
+      {
+        writeBroken({index});
+        check(loadErrorIndex(filename) == index, "помилка розбору елемента #" + to_string(index) + " біля межі частин");
+      }
+    }
+
+    long long last = static_cast<long long>(values.size()) - 1;
+    writeBroken({last, chunkFirst.back() + 5, chunkFirst.front() + 3});
+    check(loadErrorIndex(filename) == chunkFirst.front() + 3, "з кількох помилок повідомляється перша");
+    writeBroken({last});
+    check(loadErrorIndex(filename) == last, "помилка розбору останнього елемента");
+
+    // Чисел менше, ніж у заголовку: номер першого відсутнього елемента
+    {
+      ofstream file(filename, ios::binary);
+      file << values.size() + 2 << text.substr(text.find('\n'));
+    }
+    check(loadErrorIndex(filename) == static_cast<long long>(values.size()), "файл з меншою кількістю чисел, ніж у заголовку");
+
+    remove(filename.c_str());
+  }
+
+  // Усі індекси одного виклику проходять бар'єр разом; повертає кількість пройдених фаз
+  int barrierPhases(int count)
+  {
+    const int PHASES = 50;
+    SpinBarrier barrier(count);
+    atomic<int> passed(0);
+    ThreadPool::instance().runParallel(count, [&](int)
+                                       {
+                                         for (int phase = 0; phase < PHASES; phase++)
+                                           barrier.arriveAndWait();
+                                         passed.fetch_add(1); });
+    return passed.load() == count ? PHASES : 0;
+  }
+
+  // Виклики runParallel з бар'єрами з задач пулу і з кількох потоків одночасно не блокуються:
+  // кожен виклик отримує власних робітників, навіть коли інші вже зайняті
+  void testRunParallelReservations()
+  {
+    const int COUNT = 3;
+    const int callers = ThreadPool::instance().size() + 1;
+
+    atomic<int> nested(0);
+    ThreadPool::instance().runParallel(callers, [&](int)
+                                       { nested.fetch_add(barrierPhases(COUNT) > 0); });
+    check(nested.load() == callers, "вкладені виклики runParallel з бар'єрами");
+
+    atomic<int> concurrent(0);
+    vector<thread> threads;
+    for (int t = 0; t < callers; t++)
+      threads.push_back(thread([&]()
+                               { concurrent.fetch_add(barrierPhases(COUNT) > 0); }));
+    for (auto &t : threads)
+      t.join();
+    check(concurrent.load() == callers, "одночасні виклики runParallel з бар'єрами з кількох потоків");
+  }
+
+  SortMetrics autoSortSilently(vector<int> &array, const SortOptions &options)
+  {
+    SilentOutput silent;
+    return SortPlanner::autoSort(array, options);
+  }
+
+  // Профіль малих масивів, вибір рушія і передача налаштувань автоматичного режиму
+  void testSortPlanner()
+  {
+    // Масив, менший за вибірку, перевіряється повністю
+    const int small = SortPlanner::SAMPLE_SIZE / 4 + 1;
+    vector<int> reversed(small);
+    for (int i = 0; i < small; i++)
+      reversed[i] = small - i;
+    InputProfile profile = SortPlanner::profile(reversed);
+    check(profile.size == small && profile.sampleSize == small, "профіль малого масиву: вибірка дорівнює розміру");
+    check(profile.descentRatio == 1 && profile.inversionRatio == 1 && profile.duplicateRatio == 0,
+          "профіль спадного малого масиву: усі пари спадні, без повторів");
+    check(profile.estimatedRuns == small, "профіль спадного малого масиву: кожен елемент - окрема серія");
+
+    // Масиви з 0 і 1 елемента
+    for (int n : {0, 1})
+    {
+      vector<int> values(n, 42);
+      profile = SortPlanner::profile(values);
+      check(profile.size == n && profile.sampleSize == 0 && profile.estimatedRuns == n, "профіль масиву з " + to_string(n) + " елементів");
+      SortMetrics metrics = autoSortSilently(values, SortOptions());
+      check(values == vector<int>(n, 42) && metrics.additionalInfo.count("autoAlgorithm"), "автоматичне сортування масиву з " + to_string(n) + " елементів");
+    }
+
+    // Вузький діапазон: підрахунок лише зі швидким шляхом
+    vector<int> narrow(200000);
+    for (size_t i = 0; i < narrow.size(); i++)
+      narrow[i] = static_cast<int>(i * 7919 % 101);
+    profile = SortPlanner::profile(narrow);
+    check(SortPlanner::plan(profile).algorithm == "multithreaded", "вузький діапазон: сортування підрахунком");
+    check(SortPlanner::plan(profile, 0, FastPath::Disabled).algorithm != "multithreaded", "вузький діапазон без швидкого шляху: не бульбашка");
+    SortOptions options;
+    options.fastPath = FastPath::Disabled;
+    vector<int> values = narrow;
+    SortMetrics metrics = autoSortSilently(values, options);
+    check(metrics.additionalInfo.at("autoAlgorithm") != "multithreaded" && ArrayOperations::isSorted(values),
+          "автоматичне сортування передає FastPath::Disabled у план");
+
+    // Великий відсортований масив: вибірка без інверсій не веде до квадратичного сортування
+    vector<int> sorted(1 << 20);
+    for (size_t i = 0; i < sorted.size(); i++)
+      sorted[i] = static_cast<int>(3 * i);
+    SortPlan plan = SortPlanner::plan(SortPlanner::profile(sorted));
+    check(plan.algorithm == "radix", "великий відсортований масив: radix замість " + plan.algorithm);
+
+    // Оцінка рахує стільки розрядних проходів, скільки виконує рушій
+    vector<int> copy = sorted;
+    {
+      SilentOutput silent;
+      metrics = ArrayOperations::radixSort(copy);
+    }
+    string passes = metrics.additionalInfo.at("radixPasses") + " розрядних проходів";
+    check(plan.reasons.size() > 1 && plan.reasons[1].find("radix: " + passes) == 0, "план radix: " + passes + ", а не " + plan.reasons[1]);
+
+    // Інструментування і межа потоків доходять до вибраного рушія
+    for (Instrumentation instrumentation : {Instrumentation::None, Instrumentation::Counters, Instrumentation::Timeline})
+    {
+      for (const vector<int> &input : {narrow, sorted})
+      {
+        options = SortOptions();
+        options.instrumentation = instrumentation;
+        options.numThreads = 2;
+        values = input;
+        metrics = autoSortSilently(values, options);
+        string what = "auto " + metrics.additionalInfo.at("autoAlgorithm") + ", " + ArrayOperations::instrumentationName(instrumentation);
+        check(ArrayOperations::isSorted(values), what + ": масив не відсортовано");
+        check(metrics.additionalInfo.at("instrumentation") == ArrayOperations::instrumentationName(instrumentation), what + ": рушій отримав інше інструментування");
+        check((instrumentation == Instrumentation::Timeline) == (metrics.additionalInfo.count("traceEvents") > 0), what + ": сесія трасування");
+        check(stoi(metrics.additionalInfo.at("autoThreads")) <= 2, what + ": більше потоків, ніж дозволено");
+      }
+    }
+  }
+
+  // Файли в каталозі, крім перелічених
+  vector<string> extraFiles(const string &directory, const vector<string> &expected)
+  {
+    vector<string> extra;
+    for (const auto &entry : filesystem::directory_iterator(directory))
+    {
+      string name = entry.path().string();
+      if (find(expected.begin(), expected.end(), name) == expected.end())
+        extra.push_back(name);
+    }
+    return extra;
+  }
+
+  // Зовнішнє сортування з мінімальним бюджетом: кілька серій і кілька проходів злиття
+  void testExternalSort(mt19937_64 &rng)
+  {
+    const size_t budget = ExternalSort::MIN_MEMORY_BUDGET;
+    const size_t chunkElements = budget / ExternalSort::BYTES_PER_CHUNK_ELEMENT;
+    const int fanIn = static_cast<int>(min<size_t>(ExternalSort::MAX_FAN_IN, max<size_t>(2, budget / ExternalSort::MIN_MERGE_BUFFER_BYTES - 1)));
+    const string directory = "sort_engine_tests_external";
+    filesystem::remove_all(directory);
+    filesystem::create_directory(directory);
+
+    // Серій більше, ніж зливається за раз; розмір не кратний частині
+    vector<int> values = randomValues<int>(chunkElements * (fanIn + 2) + 12345, rng);
+    values[0] = INT_MIN;
+    values[values.size() / 2] = INT_MAX;
+    vector<int> expected = values;
+    sort(expected.begin(), expected.end());
+
+    int expectedRuns = static_cast<int>((values.size() + chunkElements - 1) / chunkElements);
+    int expectedPasses = 0;
+    for (int runs = expectedRuns;; runs = (runs + fanIn - 1) / fanIn)
+    {
+      expectedPasses++;
+      if (runs <= fanIn)
+        break;
+    }
+
+    for (ArrayFileFormat inputFormat : {ArrayFileFormat::Text, ArrayFileFormat::Binary})
+    {
+      bool binaryInput = inputFormat == ArrayFileFormat::Binary;
+      string what = string("external, вхід ") + (binaryInput ? "binary" : "text");
+      string input = directory + "/input.tmp";
+      string output = directory + "/output.tmp";
+      if (binaryInput)
+        ArrayFileIO::saveBinary(values, input);
+      else
+        ArrayFileIO::saveText(values, input);
+
+      // Вихід у іншому форматі, ніж вхід, щоб перевірити обидва записувачі
+      ArrayFileFormat outputFormat = binaryInput ? ArrayFileFormat::Text : ArrayFileFormat::Binary;
+      SortMetrics metrics;
+      {
+        SilentOutput silent;
+        metrics = ExternalSort::sortFile(input, output, budget, 2, outputFormat);
+      }
+
+      check(ArrayFileIO::isBinaryFile(output) == (outputFormat == ArrayFileFormat::Binary), what + ": формат результату");
+      check(ArrayOperations::loadArrayFromFile<int>(output) == expected, what + ": результат відрізняється від std::sort");
+      check(metrics.additionalInfo.at("runs") == to_string(expectedRuns), what + ": серій " + metrics.additionalInfo.at("runs"));
+      check(metrics.additionalInfo.at("mergePasses") == to_string(expectedPasses), what + ": проходів злиття " + metrics.additionalInfo.at("mergePasses"));
+      check(expectedPasses > 1, what + ": тест має вимагати більше одного проходу злиття");
+      check(extraFiles(directory, {input, output}).empty(), what + ": тимчасові серії не видалено");
+      remove(input.c_str());
+      remove(output.c_str());
+    }
+
+    // Файл, що вміщається в бюджет, сортується без серій
+    string input = directory + "/small.tmp";
+    string output = directory + "/small_sorted.tmp";
+    vector<int> small(values.begin(), values.begin() + chunkElements / 2);
+    ArrayFileIO::saveBinary(small, input);
+    SortMetrics metrics;
+    {
+      SilentOutput silent;
+      metrics = ExternalSort::sortFile(input, output, budget, 2);
+    }
+    sort(small.begin(), small.end());
+    check(ArrayOperations::loadArrayFromFile<int>(output) == small, "external, одна частина: результат відрізняється від std::sort");
+    check(metrics.additionalInfo.at("runs") == "1" && metrics.additionalInfo.at("mergePasses") == "0", "external, одна частина: без злиття");
+
+    // Помилка читання після кількох записаних серій не залишає тимчасових файлів
+    {
+      ofstream broken(input, ios::binary);
+      broken << values.size() << "\n";
+      for (size_t i = 0; i < values.size(); i++)
+        broken << (i == 3 * chunkElements + 7 ? string("x") : to_string(values[i])) << " ";
+    }
+    bool failed = false;
+    try
+    {
+      SilentOutput silent;
+      ExternalSort::sortFile(input, directory + "/broken_sorted.tmp", budget, 2);
+    }
+    catch (const runtime_error &)
+    {
+      failed = true;
+    }
+    check(failed, "external: некоректний елемент має зупинити сортування");
+    check(extraFiles(directory, {input, output}).empty(), "external: тимчасові серії не видалено після помилки");
+
+    filesystem::remove_all(directory);
+  }
+}
+
+int main()
+{
+  mt19937_64 rng(20240601);
+
+  testNumericEngines<int32_t>("int32", rng);
+  testNumericEngines<int64_t>("int64", rng);
+  testNumericEngines<float>("float", rng);
+  testNumericEngines<double>("double", rng);
+  testFloatingOrder<float>("float");
+  testFloatingOrder<double>("double");
+  testRecords(rng);
+  testRadixSort<int32_t>("int32", rng);
+  testRadixSort<int64_t>("int64", rng);
+  testCountingFastPath<int32_t>("int32", rng);
+  testCountingFastPath<int64_t>("int64", rng);
+  testFindFirstUnsorted();
+  testScanArray(rng);
+  testGeneratorDeterminism();
+  testRunParallelReservations();
+  testSortPlanner();
+  testTextWriter(rng);
+  testTextParseErrors(rng);
+  testExternalSort(rng);
+
+  testFileStreaming<int32_t>("int32", rng);
+  testFileStreaming<int64_t>("int64", rng);
+  testFileStreaming<float>("float", rng);
+  testFileStreaming<double>("double", rng);
+
+  cout << "Перевірок: " << checks << ", помилок: " << failures << endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,243 @@
+#ifndef SORT_KERNELS_H
+#define SORT_KERNELS_H
+
+#include <string>
+#include <mutex>
+#include <iostream>
+#include <algorithm>
+#include "EventTracer.h"
+#include "ElementOrder.h"
+
+using namespace std;
+
+// Мютекс для уникнення перемішування виводу з різних потоків (ArrayOperations.cpp)
+extern mutex consoleMutex;
+
+// Timestamp used in traced output (ArrayOperations.cpp)
+string currentTimestamp();
+
+// Instrumentation policies for the sort kernels.
+// A kernel is instantiated once per policy, so the uninstrumented variant has
+// no counters, no verbose checks and no branches besides the loop bounds.
+
+// Every policy implements compareExchange(data, i, j, less) for i < j: it puts
+// the smaller value at i and returns whether the values were out of order.
+// Kernels are templates over the element type and the comparator as well, so
+// each (type, order, policy) combination gets its own monomorphic loop.
+
+// No instrumentation: tight branchless compare-exchange loop
+struct NoInstrumentation
+{
+  template <typename T, typename Less>
+  bool compareExchange(T *data, int i, int j, const Less &less)
+  {
+    // Обмін без умовного переходу: мінімум ліворуч, максимум праворуч
+    return orderPair(data[i], data[j], less);
+  }
+
+  void progress(int, int) {}
+  long long getComparisons() const { return 0; }
+  long long getSwaps() const { return 0; }
+};
+
+// Comparison and swap counters, still branchless
+struct CountingInstrumentation
+{
+  long long comparisons;
+  long long swaps;
+
+  CountingInstrumentation() : comparisons(0), swaps(0) {}
+
+  template <typename T, typename Less>
+  bool compareExchange(T *data, int i, int j, const Less &less)
+  {
+    bool swapped = orderPair(data[i], data[j], less);
+    comparisons++;
+    swaps += swapped;
+    return swapped;
+  }
+
+  void progress(int, int) {}
+  long long getComparisons() const { return comparisons; }
+  long long getSwaps() const { return swaps; }
+};
+
+// Counters plus console trace of comparisons, swaps and progress
+struct TracingInstrumentation : CountingInstrumentation
+{
+  string prefix; // Наприклад "Потік 3 | "
+
+  explicit TracingInstrumentation(const string &prefix) : prefix(prefix) {}
+
+  template <typename T, typename Less>
+  bool compareExchange(T *data, int i, int j, const Less &less)
+  {
+    comparisons++;
+
+    if (comparisons % 1000 == 0)
+    { // Обмежуємо кількість виведень для продуктивності
+      lock_guard<mutex> lock(consoleMutex);
+      cout << currentTimestamp() << " | " << prefix << "Порівняння #" << comparisons << ": "
+           << data[i] << " та " << data[j] << endl;
+    }
+
+    if (less(data[j], data[i]))
+    {
+      {
+        lock_guard<mutex> lock(consoleMutex);
+        cout << currentTimestamp() << " | " << prefix << "Обмін #" << swaps + 1 << ": "
+             << data[i] << " <-> " << data[j]
+             << " (індекси " << i << " <-> " << j << ")" << endl;
+      }
+      swap(data[i], data[j]);
+      swaps++;
+      return true;
+    }
+    return false;
+  }
+
+  // total = 0 when the number of passes is not known in advance
+  void progress(int done, int total)
+  {
+    if (done % 10 == 0)
+    { // Інформація про прогрес кожні 10 ітерацій
+      lock_guard<mutex> lock(consoleMutex);
+      cout << currentTimestamp() << " | " << prefix << "Прогрес: " << done;
+      if (total > 0)
+      {
+        cout << "/" << total << " ітерацій (" << done * 100 / total << "%), ";
+      }
+      else
+      {
+        cout << " проходів, ";
+      }
+      cout << comparisons << " порівнянь, " << swaps << " обмінів" << endl;
+    }
+  }
+};
+
+// Counters plus a pass-completion event in the thread's trace ring buffer
+// (EventTracer.h): no locks and no formatting inside the sort
+struct TimelineInstrumentation : CountingInstrumentation
+{
+  void progress(int done, int) { EventTracer::instant(TracePoint::Pass, done); }
+};
+
+// Classic bubble sort of data[start, end): always n(n-1)/2 comparisons
+template <typename T, typename Less, typename Policy>
+inline void bubbleSortKernel(T *data, int start, int end, const Less &less, Policy &policy)
+{
+  for (int last = end - 1; last > start; last--)
+  {
+    for (int j = start; j < last; j++)
+    {
+      policy.compareExchange(data, j, j + 1, less);
+    }
+    policy.progress(end - last, end - start - 1);
+  }
+}
+
+// One phase of odd-even transposition sort: compare-exchange of the pairs
+// (i, i + 1) with i in [lo, hi) and i % 2 == parity. The pairs do not overlap,
+// so threads run the phase on disjoint ranges. Returns whether any pair swapped.
+template <typename T, typename Less, typename Policy>
+inline bool oddEvenPhaseKernel(T *data, int lo, int hi, int parity, const Less &less, Policy &policy)
+{
+  bool swapped = false;
+  for (int i = lo + ((lo & 1) != parity); i < hi; i += 2)
+  {
+    swapped |= policy.compareExchange(data, i, i + 1, less);
+  }
+  return swapped;
+}
+
+// Bubble sort that shrinks the bound to the last swap position and stops
+// after a pass without swaps. Returns the number of passes.
+template <typename T, typename Less, typename Policy>
+inline int earlyExitBubbleKernel(T *data, int start, int end, const Less &less, Policy &policy)
+{
+  int passes = 0;
+  int bound = end - 1; // Пари (j, j + 1) для j < bound ще не впорядковані
+
+  while (bound > start)
+  {
+    int lastSwap = start;
+    for (int j = start; j < bound; j++)
+    {
+      bool swapped = policy.compareExchange(data, j, j + 1, less);
+      lastSwap = swapped ? j : lastSwap;
+    }
+    // Усе праворуч від останнього обміну вже на своїх місцях
+    bound = lastSwap;
+    policy.progress(++passes, 0);
+  }
+
+  return passes;
+}
+
+// Cocktail-shaker sort: alternating forward and backward passes, both ends
+// shrink to the last swap position. Returns the number of passes.
+template <typename T, typename Less, typename Policy>
+inline int cocktailShakerKernel(T *data, int start, int end, const Less &less, Policy &policy)
+{
+  int passes = 0;
+  int lo = start;
+  int hi = end - 1;
+
+  while (lo < hi)
+  {
+    int lastSwap = lo;
+    for (int j = lo; j < hi; j++)
+    {
+      bool swapped = policy.compareExchange(data, j, j + 1, less);
+      lastSwap = swapped ? j : lastSwap;
+    }
+    hi = lastSwap;
+    policy.progress(++passes, 0);
+
+    int firstSwap = hi;
+    for (int j = hi - 1; j >= lo; j--)
+    {
+      bool swapped = policy.compareExchange(data, j, j + 1, less);
+      firstSwap = swapped ? j + 1 : firstSwap;
+    }
+    lo = firstSwap;
+    policy.progress(++passes, 0);
+  }
+
+  return passes;
+}
+
+// Comb sort: compare-exchange at a gap shrinking by 1.3 each pass (with the
+// "rule of 11"), finishing with bubble passes at gap 1. Iterations of a pass
+// are independent only when the gap is at least the vector width, so the wide
+// early passes can vectorize and the final small-gap passes stay scalar.
+// Returns the number of passes.
+template <typename T, typename Less, typename Policy>
+inline int combSortKernel(T *data, int start, int end, const Less &less, Policy &policy)
+{
+  int passes = 0;
+  int gap = end - start;
+  bool swapped = true;
+
+  while (gap > 1 || swapped)
+  {
+    // У long long, бо gap * 10 переповнює int для масивів понад ~214 млн елементів
+    gap = static_cast<int>(max(1LL, static_cast<long long>(gap) * 10 / 13));
+    if (gap == 9 || gap == 10)
+    {
+      gap = 11;
+    }
+
+    swapped = false;
+    for (int i = start; i + gap < end; i++)
+    {
+      swapped |= policy.compareExchange(data, i, i + gap, less);
+    }
+    policy.progress(++passes, 0);
+  }
+
+  return passes;
+}
+
+#endif // SORT_KERNELS_H
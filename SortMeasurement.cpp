@@ -0,0 +1,51 @@
+#include "SortMeasurement.h"
+#include "EventTracer.h"
+
+SortMeasurement::SortMeasurement(int numThreads, Instrumentation instrumentation, size_t inputBytes)
+    : hardwareCounters(numThreads), inputBytes(inputBytes), timeline(instrumentation == Instrumentation::Timeline), finished(false)
+{
+  // Порядок важливий: лічильники вже відкриті для всіх потоків сортування (конструктор
+  // запускає робітників пулу), буфери трасування виділяються до початку вимірювання пам'яті
+  if (timeline)
+  {
+    EventTracer::start(numThreads);
+  }
+
+  hardwareCounters.start();
+  memoryTracker.start();
+  start = Clock::now();
+  EventTracer::begin(TracePoint::Sort);
+}
+
+SortMeasurement::~SortMeasurement()
+{
+  if (finished)
+    return;
+
+  // Сортування перервано винятком: відновлюємо пік пам'яті зовнішнього вимірювання і зупиняємо сесію
+  memoryTracker.stop();
+  if (timeline)
+  {
+    EventTracer::stop();
+  }
+}
+
+SortMeasurement::Clock::time_point SortMeasurement::finish(SortMetrics &metrics)
+{
+  EventTracer::end(TracePoint::Sort);
+  Clock::time_point end = Clock::now();
+  metrics.memory = memoryTracker.stop();
+  metrics.memoryUsageBytes = inputBytes + metrics.memory.peakHeapBytes;
+  metrics.hardwareCounters = hardwareCounters.stop();
+  metrics.executionTimeMs = chrono::duration<double, milli>(end - start).count();
+  finished = true;
+
+  if (timeline)
+  {
+    EventTracer::stop();
+    metrics.additionalInfo["traceEvents"] = to_string(EventTracer::recordedEvents());
+    metrics.additionalInfo["traceDropped"] = to_string(EventTracer::droppedEvents());
+  }
+
+  return end;
+}
@@ -0,0 +1,46 @@
+#ifndef SORT_MEASUREMENT_H
+#define SORT_MEASUREMENT_H
+
+#include <chrono>
+#include "ArrayOperations.h"
+#include "HardwareCounters.h"
+#include "MemoryTracker.h"
+
+using namespace std;
+
+// Everything measured around one sort: wall-clock time, hardware counters,
+// heap and RSS, and the event tracing session of Instrumentation::Timeline.
+// Construct it right before the sorting code and call finish() right after.
+// The constructor creates the pool workers and the trace buffers before the
+// memory and time measurements begin, so neither shows up in the results;
+// the destructor closes whatever finish() did not (e.g. after an exception).
+class SortMeasurement
+{
+public:
+  // numThreads - threads the sort runs on: the calling thread and numThreads - 1 pool workers;
+  // inputBytes - memory of the sorted array, already allocated by the caller
+  SortMeasurement(int numThreads, Instrumentation instrumentation, size_t inputBytes = 0);
+  ~SortMeasurement();
+
+  typedef chrono::high_resolution_clock Clock;
+
+  Clock::time_point startTime() const { return start; }
+
+  // Stop all measurements and store them in metrics: executionTimeMs,
+  // hardwareCounters, memory, memoryUsageBytes (input plus peak heap) and
+  // the trace session size. Returns the end time of the sort.
+  Clock::time_point finish(SortMetrics &metrics);
+
+private:
+  SortMeasurement(const SortMeasurement &) = delete;
+  SortMeasurement &operator=(const SortMeasurement &) = delete;
+
+  HardwareCounters hardwareCounters;
+  MemoryTracker memoryTracker;
+  size_t inputBytes;
+  bool timeline;
+  bool finished;
+  Clock::time_point start;
+};
+
+#endif // SORT_MEASUREMENT_H
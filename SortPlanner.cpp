@@ -0,0 +1,274 @@
+#include "SortPlanner.h"
+#include "Philox.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace
+{
+  // Вартість операцій у наносекундах, виміряна на одному ядрі x86-64 для масивів до мільйонів елементів
+  const double COUNT_NS = 2.0;      // Підрахунок і запис одного елемента
+  const double BUCKET_NS = 1.0;     // Злиття і префіксна сума одного кошика
+  const double RADIX_NS = 6.0;      // Один елемент за один розрядний прохід
+  const double SIMD_NS = 1.5;       // Один елемент на рівень log2(n) сортувальної мережі і злиття
+  const double COMPARE_NS = 4.0;    // Порівняння-обмін сусідніх елементів шейкерного сортування
+  const double THREAD_NS = 20000.0; // Запуск, синхронізація і злиття результатів ще одного потоку
+  const double SETUP_NS = 5000.0;   // Буфери і задачі паралельного рушія
+
+  // Індекс у [0, count) зі слова генератора без ділення
+  int scaled(uint32_t word, int count)
+  {
+    return static_cast<int>((static_cast<uint64_t>(word) * static_cast<uint64_t>(count)) >> 32);
+  }
+
+  // Найкраща кількість потоків для паралельної роботи workNs; повертає оцінку часу
+  double parallelCost(double workNs, int maxThreads, int &threads)
+  {
+    threads = 1;
+    double best = workNs;
+    for (int t = 2; t <= maxThreads; t++)
+    {
+      double cost = workNs / t + THREAD_NS * (t - 1);
+      if (cost < best)
+      {
+        best = cost;
+        threads = t;
+      }
+    }
+    return best;
+  }
+
+  // Розрядні проходи для значень з [minValue, maxValue]: старші цифри, однакові в мінімуму і
+  // максимумі, однакові й у всіх елементів, і радикс-сортування їх пропускає
+  int radixPasses(const ValueRange &range)
+  {
+    uint32_t low = static_cast<uint32_t>(range.minValue) ^ 0x80000000u;
+    uint32_t high = static_cast<uint32_t>(range.maxValue) ^ 0x80000000u;
+    uint32_t differing = low ^ high;
+
+    int bits = 0;
+    while (differing != 0)
+    {
+      bits++;
+      differing >>= 1;
+    }
+    const int digitBits = ArrayOperations::RADIX_BITS;
+    return max(1, (bits + digitBits - 1) / digitBits);
+  }
+
+  string formatMs(double ns)
+  {
+    ostringstream out;
+    out << fixed << setprecision(3) << ns / 1e6;
+    return out.str();
+  }
+
+  string joinReasons(const vector<string> &reasons)
+  {
+    string joined;
+    for (const string &reason : reasons)
+    {
+      joined += (joined.empty() ? "" : "; ") + reason;
+    }
+    return joined;
+  }
+}
+
+InputProfile SortPlanner::profile(const vector<int> &array, int numThreads)
+{
+  auto startTime = chrono::high_resolution_clock::now();
+
+  InputProfile input;
+  int n = array.size();
+  input.size = n;
+  input.range = ArrayOperations::detectValueRange(array, numThreads);
+
+  if (n < 2)
+  {
+    input.estimatedRuns = n;
+    input.profileMs = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - startTime).count();
+    return input;
+  }
+
+  // Невеликі масиви перевіряються повністю, великі - за вибіркою з рівних страт;
+  // випадкових пар теж не більше, ніж елементів, щоб аналіз не коштував більше за сортування
+  int sampleSize = min(static_cast<int>(SAMPLE_SIZE), n);
+  int pairCount = min(sampleSize, n - 1);
+  int valueCount = sampleSize;
+  input.sampleSize = sampleSize;
+
+  int descents = 0;
+  int inversions = 0;
+  int randomPairs = 0;
+  vector<int> values(valueCount);
+
+  for (int k = 0; k < sampleSize; k++)
+  {
+    PhiloxBlock block = Philox::generate(static_cast<uint64_t>(k), SAMPLE_KEY);
+
+    if (k < pairCount)
+    {
+      // Сусідня пара зі страти k; страти не перетинаються, тож пари не повторюються
+      int first = static_cast<int>(static_cast<long long>(k) * (n - 1) / pairCount);
+      int last = static_cast<int>(static_cast<long long>(k + 1) * (n - 1) / pairCount);
+      int i = first + scaled(block.words[0], last - first);
+      descents += array[i] > array[i + 1];
+    }
+
+    if (k < valueCount)
+    {
+      int first = static_cast<int>(static_cast<long long>(k) * n / valueCount);
+      int last = static_cast<int>(static_cast<long long>(k + 1) * n / valueCount);
+      values[k] = array[first + scaled(block.words[1], last - first)];
+    }
+
+    // Випадкова пара для оцінки інверсій
+    int i = scaled(block.words[2], n);
+    int j = scaled(block.words[3], n);
+    if (i != j)
+    {
+      inversions += array[min(i, j)] > array[max(i, j)];
+      randomPairs++;
+    }
+  }
+
+  sort(values.begin(), values.end());
+  int duplicates = 0;
+  for (int k = 1; k < valueCount; k++)
+  {
+    duplicates += values[k] == values[k - 1];
+  }
+
+  double allPairs = 0.5 * n * (n - 1.0);
+  input.descentRatio = static_cast<double>(descents) / pairCount;
+  input.estimatedRuns = 1 + input.descentRatio * (n - 1);
+  input.inversionRatio = randomPairs > 0 ? static_cast<double>(inversions) / randomPairs : 0;
+  input.estimatedInversions = input.inversionRatio * allPairs;
+  input.duplicateRatio = static_cast<double>(duplicates) / valueCount;
+  input.profileMs = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - startTime).count();
+  return input;
+}
+
+SortPlan SortPlanner::plan(const InputProfile &input, int maxThreads, FastPath fastPath)
+{
+  int n = input.size;
+
+  int cores = max(1, static_cast<int>(thread::hardware_concurrency()));
+  maxThreads = maxThreads > 0 ? min(maxThreads, cores) : cores;
+  // Рушії однаково не дають потоку менше тисячі елементів
+  maxThreads = max(1, min(maxThreads, n / 1000));
+
+  struct Candidate
+  {
+    string algorithm;
+    int threads;
+    double costNs;
+    string note;
+  };
+  vector<Candidate> candidates;
+  ostringstream shape;
+  shape << "розмір " << n;
+  if (!input.range.empty)
+  {
+    shape << ", діапазон [" << input.range.minValue << ", " << input.range.maxValue << "]";
+  }
+  shape << ", серій ~" << static_cast<long long>(input.estimatedRuns)
+        << ", інверсій ~" << static_cast<long long>(input.estimatedInversions)
+        << ", повторів " << static_cast<int>(input.duplicateRatio * 100 + 0.5) << "%";
+
+  // Без швидкого шляху рушій multithreaded сортував би бульбашкою, тож кандидата немає
+  if (fastPath == FastPath::Auto && ArrayOperations::isNarrowRange(input.range, n))
+  {
+    int threads = 1;
+    double work = COUNT_NS * n + BUCKET_NS * (input.range.span() + 1);
+    double cost = SETUP_NS + parallelCost(work, maxThreads, threads);
+    candidates.push_back({"multithreaded", threads, cost, "вузький діапазон, сортування підрахунком"});
+  }
+
+  if (n > 1)
+  {
+    int passes = radixPasses(input.range);
+    int threads = 1;
+    double cost = SETUP_NS + parallelCost(RADIX_NS * n * passes, maxThreads, threads);
+    candidates.push_back({"radix", threads, cost, to_string(passes) + " розрядних проходів"});
+
+    threads = 1;
+    cost = SETUP_NS + parallelCost(SIMD_NS * n * log2(static_cast<double>(n)), maxThreads, threads);
+    candidates.push_back({"multithreaded-simd", threads, cost, "сортувальна мережа і злиття"});
+  }
+
+  // Верхня межа інверсій: вибірка без інверсій допускає 3 / sampleSize усіх пар
+  double allPairs = 0.5 * n * (n - 1.0);
+  double inversionBound = input.sampleSize > 0 ? min(1.0, input.inversionRatio + 3.0 / input.sampleSize) * allPairs : allPairs;
+  candidates.push_back({"cocktail", 1, COMPARE_NS * (n + 2 * inversionBound),
+                        "до " + to_string(static_cast<long long>(inversionBound)) + " інверсій"});
+
+  size_t best = 0;
+  for (size_t i = 1; i < candidates.size(); i++)
+  {
+    if (candidates[i].costNs < candidates[best].costNs)
+    {
+      best = i;
+    }
+  }
+
+  SortPlan chosen;
+  chosen.algorithm = candidates[best].algorithm;
+  chosen.numThreads = candidates[best].threads;
+  chosen.estimatedMs = candidates[best].costNs / 1e6;
+
+  chosen.reasons.push_back(shape.str());
+  chosen.reasons.push_back(chosen.algorithm + ": " + candidates[best].note + ", найменша оцінка часу");
+
+  string estimates = "оцінки, мс:";
+  for (const auto &candidate : candidates)
+  {
+    estimates += " " + candidate.algorithm + " " + formatMs(candidate.costNs);
+  }
+  chosen.reasons.push_back(estimates);
+
+  if (chosen.algorithm != "cocktail")
+  {
+    chosen.reasons.push_back("потоків " + to_string(chosen.numThreads) + " з " + to_string(maxThreads) +
+                             " можливих: кожен додатковий коштує ~" + formatMs(THREAD_NS) + " мс");
+  }
+
+  return chosen;
+}
+
+SortMetrics SortPlanner::autoSort(vector<int> &array, const SortOptions &options)
+{
+  InputProfile input = profile(array, options.numThreads);
+  SortPlan chosen = plan(input, options.numThreads, options.fastPath);
+
+  cout << "Автоматичний вибір: " << chosen.algorithm << " на " << chosen.numThreads << " потоках" << endl;
+
+  // Рушій отримує налаштування викликача, крім кількості потоків з плану
+  SortOptions engineOptions = options;
+  engineOptions.numThreads = chosen.numThreads;
+  SortMetrics metrics = SortRegistry::find(chosen.algorithm).run(array, engineOptions);
+
+  // Аналіз входу - частина роботи автоматичного режиму
+  metrics.executionTimeMs += input.profileMs;
+
+  ostringstream estimate;
+  estimate << fixed << setprecision(3) << chosen.estimatedMs;
+  ostringstream profileTime;
+  profileTime << fixed << setprecision(3) << input.profileMs;
+  ostringstream duplicates;
+  duplicates << fixed << setprecision(3) << input.duplicateRatio;
+
+  metrics.additionalInfo["autoAlgorithm"] = chosen.algorithm;
+  metrics.additionalInfo["autoThreads"] = to_string(chosen.numThreads);
+  metrics.additionalInfo["autoEstimatedMs"] = estimate.str();
+  metrics.additionalInfo["autoProfileMs"] = profileTime.str();
+  metrics.additionalInfo["autoReason"] = joinReasons(chosen.reasons);
+  metrics.additionalInfo["sampleRuns"] = to_string(static_cast<long long>(input.estimatedRuns));
+  metrics.additionalInfo["sampleInversions"] = to_string(static_cast<long long>(input.estimatedInversions));
+  metrics.additionalInfo["sampleDuplicateRatio"] = duplicates.str();
+  return metrics;
+}
@@ -0,0 +1,80 @@
+#ifndef SORT_PLANNER_H
+#define SORT_PLANNER_H
+
+#include <vector>
+#include <string>
+#include "ArrayOperations.h"
+#include "SortRegistry.h"
+
+using namespace std;
+
+// Shape of an input array as seen by the planner. The value range is exact
+// (one parallel read); presortedness and duplicates are estimated from a
+// deterministic sample, so the same array always gets the same plan.
+struct InputProfile
+{
+  int size;
+  ValueRange range;
+  int sampleSize;             // Кількість вибраних пар і значень
+  double descentRatio;        // Частка сусідніх пар з array[i] > array[i + 1]
+  double estimatedRuns;       // Зростаючих серій: 1 + descentRatio * (size - 1)
+  double inversionRatio;      // Частка випадкових пар i < j з array[i] > array[j]
+  double estimatedInversions; // inversionRatio * size * (size - 1) / 2
+  double duplicateRatio;      // Частка вибраних значень, що повторюють інше вибране значення
+  double profileMs;           // Час аналізу входу
+
+  InputProfile()
+      : size(0), sampleSize(0), descentRatio(0), estimatedRuns(0), inversionRatio(0),
+        estimatedInversions(0), duplicateRatio(0), profileMs(0) {}
+};
+
+// Engine and thread count chosen for an input, with the reasons
+struct SortPlan
+{
+  string algorithm;       // Назва рушія в SortRegistry
+  int numThreads;         // 1 для послідовних рушіїв
+  double estimatedMs;     // Оцінка часу вибраного рушія
+  vector<string> reasons; // Пояснення вибору для метрик
+
+  SortPlan() : numThreads(1), estimatedMs(0) {}
+};
+
+// The "auto" engine: profiles the input, estimates the time of each candidate
+// engine with a cost model and runs the cheapest one.
+//
+// Candidates (costs in nanoseconds, constants in SortPlanner.cpp):
+//   multithreaded on a narrow range (counting sort)   COUNT_NS * n + BUCKET_NS * range
+//   radix                                             RADIX_NS * n * digit passes
+//   multithreaded-simd                                SIMD_NS * n * log2(n)
+//   cocktail, sequential                              COMPARE_NS * (n + 2 * inversions)
+// Parallel work W on T threads costs W / T + THREAD_NS * (T - 1); T is the best
+// count up to the cores, maxThreads and one thread per thousand elements.
+// The inversions of the cocktail sort are an upper bound: a sample with no
+// inversions still allows 3 / sampleSize of all pairs (rule of three), so a
+// lucky sample never sends a large array to a quadratic sort. The other
+// bubble engines are quadratic on any input and are not candidates.
+class SortPlanner
+{
+public:
+  // Measure the shape of the array (0 threads = auto)
+  static InputProfile profile(const vector<int> &array, int numThreads = 0);
+
+  // Choose the engine and thread count for a profiled input (0 threads = all
+  // cores). With FastPath::Disabled counting sort is not a candidate.
+  static SortPlan plan(const InputProfile &profile, int maxThreads = 0, FastPath fastPath = FastPath::Auto);
+
+  // Profile, plan and sort. options.numThreads is the thread limit; the other
+  // options are passed to the chosen engine. The metrics are the engine's plus
+  // the plan in additionalInfo ("autoAlgorithm", "autoThreads", "autoReason",
+  // ...); the execution time includes the profiling.
+  static SortMetrics autoSort(vector<int> &array, const SortOptions &options = SortOptions());
+
+  // Pairs and values in the sample; smaller arrays are scanned completely
+  static const int SAMPLE_SIZE = 4096;
+
+private:
+  // Philox key of the sample positions
+  static const uint64_t SAMPLE_KEY = 0x5AD0C0FFEEULL;
+};
+
+#endif // SORT_PLANNER_H
@@ -0,0 +1,67 @@
+#include "SortRegistry.h"
+#include "SortPlanner.h"
+#include <stdexcept>
+
+namespace
+{
+  vector<SortAlgorithm> createAlgorithms()
+  {
+    vector<SortAlgorithm> algorithms;
+
+    algorithms.push_back({"bubble", "послідовне сортування методом бульбашки", false,
+                          [](vector<int> &array, const SortOptions &options)
+                          { return ArrayOperations::bubbleSort(array, options.instrumentation, options.fastPath); }});
+
+    algorithms.push_back({"multithreaded", "багатопотокове сортування бульбашкою з k-шляховим злиттям", true,
+                          [](vector<int> &array, const SortOptions &options)
+                          { return ArrayOperations::bubbleSortMultithreaded(array, options.numThreads, options.instrumentation, SegmentKernel::Bubble, options.fastPath); }});
+
+    algorithms.push_back({"multithreaded-simd", "багатопотокове сортування з SIMD-ядром сегментів", true,
+                          [](vector<int> &array, const SortOptions &options)
+                          { return ArrayOperations::bubbleSortMultithreaded(array, options.numThreads, options.instrumentation, SegmentKernel::Simd, options.fastPath); }});
+
+    algorithms.push_back({"odd-even", "паралельне парно-непарне сортування", true,
+                          [](vector<int> &array, const SortOptions &options)
+                          { return ArrayOperations::oddEvenSortMultithreaded(array, options.numThreads, options.instrumentation); }});
+
+    algorithms.push_back({"radix", "паралельне порозрядне сортування (LSD, " + to_string(ArrayOperations::RADIX_BITS) + "-бітні цифри)", true,
+                          [](vector<int> &array, const SortOptions &options)
+                          { return ArrayOperations::radixSort(array, options.numThreads, options.instrumentation); }});
+
+    algorithms.push_back({"auto", "автоматичний вибір рушія і кількості потоків за аналізом входу", true,
+                          [](vector<int> &array, const SortOptions &options)
+                          { return SortPlanner::autoSort(array, options); }});
+
+    const BubbleVariant variants[] = {BubbleVariant::EarlyExit, BubbleVariant::CocktailShaker, BubbleVariant::Comb};
+    const char *descriptions[] = {"бульбашка з ранньою зупинкою", "шейкерне сортування", "сортування гребінцем"};
+    for (int i = 0; i < 3; i++)
+    {
+      BubbleVariant variant = variants[i];
+      algorithms.push_back({ArrayOperations::bubbleVariantName(variant), descriptions[i], false,
+                            [variant](vector<int> &array, const SortOptions &options)
+                            { return ArrayOperations::adaptiveBubbleSort(array, variant, options.instrumentation); }});
+    }
+
+    return algorithms;
+  }
+}
+
+const vector<SortAlgorithm> &SortRegistry::all()
+{
+  static const vector<SortAlgorithm> algorithms = createAlgorithms();
+  return algorithms;
+}
+
+const SortAlgorithm &SortRegistry::find(const string &name)
+{
+  string known;
+  for (const auto &algorithm : all())
+  {
+    if (algorithm.name == name)
+    {
+      return algorithm;
+    }
+    known += (known.empty() ? "" : ", ") + algorithm.name;
+  }
+  throw runtime_error("Невідомий алгоритм: " + name + " (доступні: " + known + ")");
+}
@@ -0,0 +1,43 @@
+#ifndef SORT_REGISTRY_H
+#define SORT_REGISTRY_H
+
+#include <vector>
+#include <string>
+#include <functional>
+#include "ArrayOperations.h"
+
+using namespace std;
+
+// Settings shared by all in-memory sort engines; an engine ignores the ones
+// it does not support (e.g. thread count for sequential sorts)
+struct SortOptions
+{
+  int numThreads; // 0 - автоматичне визначення
+  Instrumentation instrumentation;
+  FastPath fastPath; // Сортування підрахунком вузького діапазону в бульбашкових рушіях
+
+  SortOptions() : numThreads(0), instrumentation(Instrumentation::Counters), fastPath(FastPath::Auto) {}
+};
+
+// One in-memory sort engine addressable by name
+struct SortAlgorithm
+{
+  string name;        // Ідентифікатор для командного рядка і результатів
+  string description; // Опис українською для довідки
+  bool parallel;      // Чи використовує numThreads
+  function<SortMetrics(vector<int> &, const SortOptions &)> run;
+};
+
+// Name-based dispatcher over the sort engines of ArrayOperations, used by the
+// batch mode and the benchmark
+class SortRegistry
+{
+public:
+  // All engines in a stable order
+  static const vector<SortAlgorithm> &all();
+
+  // Engine by name; throws runtime_error listing the known names
+  static const SortAlgorithm &find(const string &name);
+};
+
+#endif // SORT_REGISTRY_H
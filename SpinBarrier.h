@@ -0,0 +1,93 @@
+#ifndef SPIN_BARRIER_H
+#define SPIN_BARRIER_H
+
+#include <atomic>
+#include <climits>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Reusable barrier for a fixed group of threads.
+// Waiting threads spin briefly and then sleep on a futex (or yield on
+// non-Linux systems), so barrier-heavy algorithms stay cheap when every
+// thread has its own core and do not burn the CPU when cores are shared.
+class SpinBarrier
+{
+public:
+  explicit SpinBarrier(int count) : count(count), remaining(count), generation(0), sleepers(0) {}
+
+  SpinBarrier(const SpinBarrier &) = delete;
+  SpinBarrier &operator=(const SpinBarrier &) = delete;
+
+  // Block until all threads of the group have arrived
+  void arriveAndWait()
+  {
+    unsigned gen = generation.load(memory_order_acquire);
+
+    if (remaining.fetch_sub(1, memory_order_acq_rel) == 1)
+    {
+      // Останній потік відкриває бар'єр для наступного покоління
+      remaining.store(count, memory_order_relaxed);
+      generation.fetch_add(1, memory_order_seq_cst);
+      if (sleepers.load(memory_order_seq_cst) > 0)
+      {
+        wakeAll();
+      }
+      return;
+    }
+
+    for (int spins = 0; generation.load(memory_order_acquire) == gen; spins++)
+    {
+      if (spins < SPIN_LIMIT)
+      {
+        cpuRelax();
+      }
+      else
+      {
+        sleepers.fetch_add(1, memory_order_seq_cst);
+        waitWhileGeneration(gen);
+        sleepers.fetch_sub(1, memory_order_relaxed);
+      }
+    }
+  }
+
+private:
+  static const int SPIN_LIMIT = 256;
+
+  const int count;
+  atomic<int> remaining;
+  atomic<unsigned> generation;
+  atomic<int> sleepers;
+
+  static void cpuRelax()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+  }
+
+  void waitWhileGeneration(unsigned gen)
+  {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<unsigned *>(&generation), FUTEX_WAIT_PRIVATE, gen, nullptr, nullptr, 0);
+#else
+    (void)gen;
+    this_thread::yield();
+#endif
+  }
+
+  void wakeAll()
+  {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<unsigned *>(&generation), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif
+  }
+};
+
+#endif // SPIN_BARRIER_H
@@ -0,0 +1,209 @@
+#include "ThreadPool.h"
+#include <chrono>
+#include <stdexcept>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+  long long steadyNowNs()
+  {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+  }
+}
+
+ThreadPool &ThreadPool::instance()
+{
+  static ThreadPool pool(thread::hardware_concurrency() > 0 ? thread::hardware_concurrency() : 4);
+  return pool;
+}
+
+ThreadPool::ThreadPool(int numWorkers)
+    : stopping(false), tasksCompleted(0), busyTimeNs(0), reservedWorkers(0), idleTimeNs(0), parkedWorkers(0), parkedSinceNs(0)
+{
+  ensureWorkers(numWorkers);
+}
+
+ThreadPool::~ThreadPool()
+{
+  shutdown();
+}
+
+void ThreadPool::ensureWorkers(int count)
+{
+  lock_guard<mutex> lock(queueMutex);
+  if (stopping)
+  {
+    throw runtime_error("Пул потоків уже зупинено");
+  }
+
+  while (static_cast<int>(workers.size()) < count)
+  {
+    workers.push_back(thread(&ThreadPool::workerLoop, this));
+  }
+}
+
+int ThreadPool::size()
+{
+  lock_guard<mutex> lock(queueMutex);
+  return workers.size();
+}
+
+future<void> ThreadPool::submit(function<void()> task)
+{
+  packaged_task<void()> packaged(move(task));
+  future<void> result = packaged.get_future();
+  {
+    lock_guard<mutex> lock(queueMutex);
+    if (stopping)
+    {
+      throw runtime_error("Пул потоків уже зупинено");
+    }
+    tasks.push_back(move(packaged));
+  }
+  queueCondition.notify_one();
+  return result;
+}
+
+void ThreadPool::runParallel(int count, const function<void(int)> &task)
+{
+  if (count <= 0)
+    return;
+
+  // Кожен індекс, крім нульового, потребує окремого робітника, інакше бар'єри заблокуються.
+  // Робітники інших викликів (зокрема того, з задачі якого зроблено цей виклик) уже зайняті,
+  // тому резервуються понад них
+  struct Reservation
+  {
+    ThreadPool &pool;
+    int workers;
+
+    ~Reservation()
+    {
+      lock_guard<mutex> lock(pool.queueMutex);
+      pool.reservedWorkers -= workers;
+    }
+  };
+
+  int needed;
+  {
+    lock_guard<mutex> lock(queueMutex);
+    reservedWorkers += count - 1;
+    needed = reservedWorkers;
+  }
+  Reservation reservation{*this, count - 1};
+  ensureWorkers(needed);
+
+  vector<future<void>> futures;
+  for (int i = 1; i < count; i++)
+  {
+    futures.push_back(submit([&task, i]()
+                             { task(i); }));
+  }
+
+  // Нульовий індекс виконується на викликаючому потоці
+  exception_ptr error;
+  try
+  {
+    task(0);
+  }
+  catch (...)
+  {
+    error = current_exception();
+  }
+
+  for (auto &f : futures)
+  {
+    try
+    {
+      f.get();
+    }
+    catch (...)
+    {
+      if (!error)
+        error = current_exception();
+    }
+  }
+
+  if (error)
+  {
+    rethrow_exception(error);
+  }
+}
+
+void ThreadPool::shutdown()
+{
+  {
+    lock_guard<mutex> lock(queueMutex);
+    if (stopping)
+      return;
+    stopping = true;
+  }
+  queueCondition.notify_all();
+
+  for (auto &worker : workers)
+  {
+    worker.join();
+  }
+}
+
+vector<pid_t> ThreadPool::threadIds()
+{
+  // Новий робітник записує свій id лише після старту, тому чекаємо всіх
+  unique_lock<mutex> lock(queueMutex);
+  startedCondition.wait(lock, [this]()
+                        { return workerThreadIds.size() == workers.size(); });
+  return workerThreadIds;
+}
+
+ThreadPoolStats ThreadPool::getStats()
+{
+  ThreadPoolStats stats;
+  {
+    lock_guard<mutex> lock(queueMutex);
+    stats.numWorkers = workers.size();
+    // Робітники, що зараз чекають, додають очікування до цього моменту
+    long long idleNs = idleTimeNs + parkedWorkers * steadyNowNs() - parkedSinceNs;
+    stats.idleTimeMs = idleNs / 1e6;
+  }
+  stats.tasksCompleted = tasksCompleted.load();
+  stats.busyTimeMs = busyTimeNs.load() / 1e6;
+  return stats;
+}
+
+void ThreadPool::workerLoop()
+{
+  {
+    lock_guard<mutex> lock(queueMutex);
+    workerThreadIds.push_back(static_cast<pid_t>(syscall(SYS_gettid)));
+  }
+  startedCondition.notify_all();
+
+  while (true)
+  {
+    packaged_task<void()> task;
+    {
+      unique_lock<mutex> lock(queueMutex);
+      long long idleStart = steadyNowNs();
+      parkedWorkers++;
+      parkedSinceNs += idleStart;
+      queueCondition.wait(lock, [this]()
+                          { return stopping || !tasks.empty(); });
+      parkedWorkers--;
+      parkedSinceNs -= idleStart;
+      idleTimeNs += steadyNowNs() - idleStart;
+
+      // Під час зупинки спочатку доробляємо всі задачі з черги
+      if (tasks.empty())
+        return;
+
+      task = move(tasks.front());
+      tasks.pop_front();
+    }
+
+    auto busyStart = chrono::steady_clock::now();
+    task(); // Виняток зберігається у future задачі
+    busyTimeNs += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - busyStart).count();
+    tasksCompleted++;
+  }
+}
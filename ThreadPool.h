@@ -0,0 +1,92 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <atomic>
+#include <sys/types.h>
+
+using namespace std;
+
+struct ThreadPoolStats
+{
+  int numWorkers;
+  long long tasksCompleted;
+  double idleTimeMs; // Сумарний час очікування робітників на задачі, разом з очікуванням, що триває
+  double busyTimeMs; // Сумарний час виконання задач
+
+  ThreadPoolStats() : numWorkers(0), tasksCompleted(0), idleTimeMs(0), busyTimeMs(0) {}
+};
+
+// Process-wide pool of worker threads shared by all sorting routines.
+// Created on first use with hardware_concurrency workers; grows on demand when
+// a routine needs more threads running at the same time (e.g. barrier phases).
+class ThreadPool
+{
+public:
+  // Get the shared pool
+  static ThreadPool &instance();
+
+  // Submit a task; the future reports completion and rethrows its exception
+  future<void> submit(function<void()> task);
+
+  // Run task(0..count-1) concurrently: index 0 on the calling thread, the rest
+  // on pool workers. Every call reserves its count - 1 workers (the pool grows
+  // when they are all reserved), so all indices are guaranteed to run at the
+  // same time and tasks may synchronize with each other (barriers), also when
+  // runParallel is called from a pool task or from several threads at once.
+  // Tasks of submit() are not reserved and must not wait for such indices.
+  void runParallel(int count, const function<void(int)> &task);
+
+  // Make sure at least `count` workers exist
+  void ensureWorkers(int count);
+
+  // Number of worker threads
+  int size();
+
+  // Kernel thread ids of all workers (for per-thread perf counters)
+  vector<pid_t> threadIds();
+
+  // Finish queued tasks and stop all workers; further submissions throw
+  void shutdown();
+
+  // Snapshot of pool statistics since creation. Idle time includes the
+  // current wait of parked workers, so the difference of two snapshots is the
+  // idle time between them.
+  ThreadPoolStats getStats();
+
+  ~ThreadPool();
+
+private:
+  explicit ThreadPool(int numWorkers);
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  void workerLoop();
+
+  mutex queueMutex;
+  condition_variable queueCondition;
+  deque<packaged_task<void()>> tasks;
+  vector<thread> workers;
+  vector<pid_t> workerThreadIds;
+  condition_variable startedCondition; // Робітник записав свій id
+  bool stopping;
+
+  atomic<long long> tasksCompleted;
+  atomic<long long> busyTimeNs;
+
+  // Під захистом queueMutex: робітники, зарезервовані незавершеними викликами runParallel
+  int reservedWorkers;
+
+  // Під захистом queueMutex: завершені очікування і початки поточних
+  long long idleTimeNs;
+  int parkedWorkers;
+  long long parkedSinceNs; // Сума моментів початку очікування (steady_clock) робітників, що чекають
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,257 @@
+#include "WorkStealingScheduler.h"
+#include "ThreadPool.h"
+#include "EventTracer.h"
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <ctime>
+#include <climits>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  // Процесорний час поточного потоку в мілісекундах
+  double threadCpuMs()
+  {
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec * 1e3 + now.tv_nsec / 1e6;
+  }
+
+  void cpuRelax()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+  }
+
+  // Планувальник і робітник, які виконують поточну задачу на цьому потоці
+  thread_local const WorkStealingScheduler *currentScheduler = nullptr;
+  thread_local int currentWorkerIndex = -1;
+}
+
+WorkStealingScheduler::WorkStealingScheduler(int numWorkers)
+    : runMs(0), pending(0), nextWorker(0), workEpoch(0), sleepers(0)
+{
+  numWorkers = max(1, numWorkers);
+  for (int i = 0; i < numWorkers; i++)
+  {
+    workers.push_back(unique_ptr<Worker>(new Worker(0x9E3779B9u * (i + 1))));
+  }
+}
+
+int WorkStealingScheduler::currentWorker() const
+{
+  return currentScheduler == this ? currentWorkerIndex : -1;
+}
+
+void WorkStealingScheduler::spawn(Task task)
+{
+  int index = currentWorker();
+  if (index < 0)
+  {
+    index = nextWorker.fetch_add(1, memory_order_relaxed) % getNumWorkers();
+  }
+
+  // Лічильник збільшується до появи задачі в черзі, щоб робітники не завершились передчасно
+  pending.fetch_add(1, memory_order_acq_rel);
+
+  Worker &worker = *workers[index];
+  {
+    lock_guard<mutex> lock(worker.dequeMutex);
+    worker.tasks.push_back(move(task));
+  }
+
+  // Нова епоха після появи задачі в черзі: робітник, який уже перевірив черги, не засне
+  workEpoch.fetch_add(1, memory_order_seq_cst);
+  if (sleepers.load(memory_order_seq_cst) > 0)
+  {
+    wakeWorkers(1);
+  }
+}
+
+bool WorkStealingScheduler::anyQueuedTask()
+{
+  for (auto &worker : workers)
+  {
+    lock_guard<mutex> lock(worker->dequeMutex);
+    if (!worker->tasks.empty())
+      return true;
+  }
+  return false;
+}
+
+void WorkStealingScheduler::sleepUntilWork()
+{
+  // Спочатку реєструємось і запам'ятовуємо епоху, потім перевіряємо черги: задача,
+  // що з'явиться після перевірки, змінить епоху, і futex не дасть заснути
+  sleepers.fetch_add(1, memory_order_seq_cst);
+  unsigned epoch = workEpoch.load(memory_order_seq_cst);
+
+  if (pending.load(memory_order_acquire) > 0 && !anyQueuedTask())
+  {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<unsigned *>(&workEpoch), FUTEX_WAIT_PRIVATE, epoch, nullptr, nullptr, 0);
+#else
+    (void)epoch;
+    this_thread::yield();
+#endif
+  }
+
+  sleepers.fetch_sub(1, memory_order_relaxed);
+}
+
+void WorkStealingScheduler::wakeWorkers(int count)
+{
+#ifdef __linux__
+  syscall(SYS_futex, reinterpret_cast<unsigned *>(&workEpoch), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#else
+  (void)count;
+#endif
+}
+
+bool WorkStealingScheduler::popLocal(int index, Task &task)
+{
+  Worker &worker = *workers[index];
+  lock_guard<mutex> lock(worker.dequeMutex);
+  if (worker.tasks.empty())
+    return false;
+
+  task = move(worker.tasks.back());
+  worker.tasks.pop_back();
+  return true;
+}
+
+bool WorkStealingScheduler::steal(int index, Task &task)
+{
+  int numWorkers = getNumWorkers();
+  if (numWorkers == 1)
+    return false;
+
+  Worker &self = *workers[index];
+  uniform_int_distribution<int> pickVictim(0, numWorkers - 2);
+
+  for (int attempt = 0; attempt < numWorkers; attempt++)
+  {
+    // Випадкова жертва, відмінна від самого робітника
+    int victim = pickVictim(self.rng);
+    if (victim >= index)
+      victim++;
+
+    Worker &other = *workers[victim];
+    lock_guard<mutex> lock(other.dequeMutex);
+    if (!other.tasks.empty())
+    {
+      task = move(other.tasks.front());
+      other.tasks.pop_front();
+      self.steals++;
+      EventTracer::instant(TracePoint::Steal, victim);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void WorkStealingScheduler::workerLoop(int index)
+{
+  currentScheduler = this;
+  currentWorkerIndex = index;
+  Worker &self = *workers[index];
+  self.startMs = chrono::duration<double, milli>(chrono::steady_clock::now() - runStart).count();
+  double cpuStart = threadCpuMs();
+
+  int failures = 0;
+  while (pending.load(memory_order_acquire) > 0)
+  {
+    Task task;
+    if (popLocal(index, task) || steal(index, task))
+    {
+      failures = 0;
+      auto start = chrono::steady_clock::now();
+      double taskCpuStart = threadCpuMs();
+      try
+      {
+        task(*this);
+      }
+      catch (...)
+      {
+        lock_guard<mutex> lock(errorMutex);
+        if (!firstError)
+          firstError = current_exception();
+      }
+      self.busyMs += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+      self.taskCpuMs += threadCpuMs() - taskCpuStart;
+      self.executed++;
+      if (pending.fetch_sub(1, memory_order_acq_rel) == 1)
+      {
+        // Остання задача: сплячі робітники мають прокинутись і завершитись
+        workEpoch.fetch_add(1, memory_order_seq_cst);
+        if (sleepers.load(memory_order_seq_cst) > 0)
+        {
+          wakeWorkers(INT_MAX);
+        }
+      }
+    }
+    else if (++failures < SPIN_LIMIT)
+    {
+      cpuRelax();
+    }
+    else
+    {
+      sleepUntilWork();
+    }
+  }
+
+  self.cpuMs = threadCpuMs() - cpuStart;
+  self.endMs = chrono::duration<double, milli>(chrono::steady_clock::now() - runStart).count();
+
+  currentScheduler = nullptr;
+  currentWorkerIndex = -1;
+}
+
+void WorkStealingScheduler::run()
+{
+  runStart = chrono::steady_clock::now();
+  ThreadPool::instance().runParallel(getNumWorkers(), [this](int index)
+                                     { workerLoop(index); });
+  runMs = chrono::duration<double, milli>(chrono::steady_clock::now() - runStart).count();
+
+  if (firstError)
+  {
+    exception_ptr error = firstError;
+    firstError = nullptr;
+    rethrow_exception(error);
+  }
+}
+
+WorkStealingStats WorkStealingScheduler::getStats() const
+{
+  WorkStealingStats stats;
+  double totalBusy = 0;
+  double maxBusy = 0;
+
+  for (const auto &worker : workers)
+  {
+    stats.tasksExecuted += worker->executed;
+    stats.steals += worker->steals;
+    stats.workerBusyMs.push_back(worker->busyMs);
+    stats.workerTasks.push_back(worker->executed);
+    stats.workerCpuMs.push_back(worker->cpuMs);
+    stats.workerTaskCpuMs.push_back(worker->taskCpuMs);
+    stats.workerStartMs.push_back(worker->startMs);
+    stats.workerEndMs.push_back(worker->endMs);
+    totalBusy += worker->busyMs;
+    maxBusy = max(maxBusy, worker->busyMs);
+  }
+
+  stats.runMs = runMs;
+  double meanBusy = totalBusy / workers.size();
+  stats.loadImbalance = meanBusy > 0 ? maxBusy / meanBusy : 1.0;
+  return stats;
+}
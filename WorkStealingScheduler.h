@@ -0,0 +1,99 @@
+#ifndef WORK_STEALING_SCHEDULER_H
+#define WORK_STEALING_SCHEDULER_H
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <functional>
+#include <exception>
+#include <chrono>
+
+using namespace std;
+
+struct WorkStealingStats
+{
+  long long tasksExecuted;
+  long long steals;
+  double loadImbalance;          // Максимальний час роботи робітника / середній
+  vector<double> workerBusyMs;   // Час виконання задач кожним робітником
+  vector<long long> workerTasks; // Кількість задач кожного робітника
+  vector<double> workerCpuMs;    // Процесорний час робітника за run() (CLOCK_THREAD_CPUTIME_ID)
+  vector<double> workerTaskCpuMs; // Процесорний час робітника лише на виконання задач
+  vector<double> workerStartMs;  // Старт циклу робітника від початку run()
+  vector<double> workerEndMs;    // Завершення циклу робітника від початку run()
+  double runMs;                  // Тривалість run() на викликаючому потоці
+
+  WorkStealingStats() : tasksExecuted(0), steals(0), loadImbalance(1.0), runMs(0) {}
+};
+
+// Task scheduler with one deque per worker.
+// A worker pops its own newest task (LIFO, cache-friendly) and, when its deque
+// is empty, steals the oldest task of a randomly chosen victim (FIFO). Tasks
+// may spawn subtasks. Workers run on the shared ThreadPool. A worker that finds
+// nothing to do spins briefly and then sleeps on a futex until a task is
+// spawned or all tasks are done, so idle workers do not take the CPU from the
+// busy ones when cores are shared.
+class WorkStealingScheduler
+{
+public:
+  typedef function<void(WorkStealingScheduler &)> Task;
+
+  explicit WorkStealingScheduler(int numWorkers);
+
+  // Queue a task. Inside a task it goes to the current worker's deque,
+  // otherwise tasks are distributed round-robin.
+  void spawn(Task task);
+
+  // Execute all queued tasks (and everything they spawn); rethrows the first task exception
+  void run();
+
+  // Index of the worker running the current task (-1 outside of run())
+  int currentWorker() const;
+
+  int getNumWorkers() const { return static_cast<int>(workers.size()); }
+
+  WorkStealingStats getStats() const;
+
+private:
+  struct Worker
+  {
+    mutex dequeMutex;
+    deque<Task> tasks;
+    mt19937 rng;
+    long long executed;
+    long long steals;
+    double busyMs;
+    double cpuMs;
+    double taskCpuMs;
+    double startMs;
+    double endMs;
+
+    explicit Worker(unsigned seed) : rng(seed), executed(0), steals(0), busyMs(0), cpuMs(0), taskCpuMs(0), startMs(0), endMs(0) {}
+  };
+
+  // Failed attempts to find a task before an idle worker goes to sleep
+  static const int SPIN_LIMIT = 256;
+
+  vector<unique_ptr<Worker>> workers;
+  chrono::steady_clock::time_point runStart;
+  double runMs;
+  atomic<long long> pending;
+  atomic<int> nextWorker;
+  atomic<unsigned> workEpoch; // Змінюється з кожною новою задачею і після останньої (слово futex)
+  atomic<int> sleepers;       // Робітники, що сплять на workEpoch
+
+  mutex errorMutex;
+  exception_ptr firstError;
+
+  void workerLoop(int index);
+  bool popLocal(int index, Task &task);
+  bool steal(int index, Task &task);
+  bool anyQueuedTask();
+  void sleepUntilWork();
+  void wakeWorkers(int count);
+};
+
+#endif // WORK_STEALING_SCHEDULER_H
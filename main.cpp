@@ -1,10 +1,15 @@
 #include "ArrayOperations.h"
 #include "MenuFunctions.h"
+#include "ExternalSort.h"
+#include "SortPlanner.h"
+#include "BatchMode.h"
+#include "EventTracer.h"
 #include <iostream>
 #include <string>
 #include <vector>
 #include <algorithm>
 #include <iomanip>
+#include <functional>
 
 using namespace std;
 
@@ -28,6 +33,7 @@ int showArrayMenu()
   cout << "3. Зберегти поточний масив у файл\n";
   cout << "4. Показати масив\n";
   cout << "5. Інформація про масив\n";
+  cout << "6. Згенерувати масив заданої форми (відсортований, пилка, Ципф...)\n";
   cout << "0. Повернутися до головного меню\n";
   return getIntInput("Ваш вибір: ");
 }
@@ -38,19 +44,110 @@ int showSortMenu()
   cout << "\n===== СОРТУВАННЯ ТА АНАЛІЗ =====\n";
   cout << "1. Сортувати методом бульбашки (послідовно)\n";
   cout << "2. Сортувати методом бульбашки (багатопотоково)\n";
-  cout << "3. Перевірити чи масив відсортований\n";
-  cout << "4. Показати метрики останнього сортування\n";
+  cout << "3. Сортувати парно-непарним методом (паралельно)\n";
+  cout << "4. Адаптивні варіанти (рання зупинка, шейкер, гребінець)\n";
+  cout << "5. Перевірити чи масив відсортований\n";
+  cout << "6. Показати метрики останнього сортування\n";
+  cout << "7. Зовнішнє сортування файлу (більшого за пам'ять)\n";
+  cout << "8. Порозрядне сортування (паралельне LSD radix)\n";
+  cout << "9. Автоматичний вибір методу і кількості потоків\n";
   cout << "0. Повернутися до головного меню\n";
   return getIntInput("Ваш вибір: ");
 }
 
-int main()
+// Кількість потоків, використаних сортуванням (1 для послідовних алгоритмів)
+int usedThreads(const SortMetrics &metrics)
 {
+  auto it = metrics.additionalInfo.find("numThreads");
+  return it != metrics.additionalInfo.end() ? stoi(it->second) : 1;
+}
+
+// Записує походження згенерованого масиву (seed, розподіл) у метрики, щоб запуск можна було відтворити
+void recordArrayOrigin(SortMetrics &metrics, const map<string, string> &arrayOrigin)
+{
+  for (const auto &entry : arrayOrigin)
+  {
+    metrics.additionalInfo[entry.first] = entry.second;
+  }
+}
+
+// Сортує копію масиву, перевіряє результат, зберігає метрики для порівняння
+// і пропонує замінити оригінальний масив відсортованим (походження тоді вже не описує масив)
+void sortCopyAndReport(vector<int> &array, map<string, string> &arrayOrigin, const string &name, const function<SortMetrics(vector<int> &)> &sortFunction,
+                       SortMetrics &lastMetrics, vector<SortResult> &sortResults)
+{
+  // Зберігаємо копію масиву для можливості порівняння результатів; її пам'ять теж вимірюється
+  MemoryTracker copyTracker;
+  copyTracker.start();
+  vector<int> arrayCopy = array;
+  MemoryUsage copyUsage = copyTracker.stop();
+
+  lastMetrics = sortFunction(arrayCopy);
+  recordArrayOrigin(lastMetrics, arrayOrigin);
+  lastMetrics.additionalInfo["arrayCopyBytes"] = to_string(copyUsage.peakHeapBytes);
+
+  // Одне сканування результату дає і перевірку, і статистику для метрик
+  ArrayStatistics<int> resultStats = ArrayOperations::scanArray(arrayCopy);
+  ArrayOperations::recordStatistics(lastMetrics, resultStats);
+
+  if (resultStats.sorted)
+  {
+    cout << "Масив успішно відсортований.\n";
+  }
+  else
+  {
+    cout << "Масив НЕ відсортований: перше порушення порядку на індексі " << resultStats.firstUnsortedIndex << ".\n";
+  }
+
+  if (resultStats.sorted)
+  {
+    ArrayOperations::printMetrics(lastMetrics);
+
+    // Сесія трасування завершилась разом із сортуванням, тепер її можна записати
+    if (lastMetrics.additionalInfo.count("traceEvents"))
+    {
+      string traceFile = getStringInput("Введіть ім'я файлу для часової шкали (Chrome trace JSON): ");
+      try
+      {
+        EventTracer::writeChromeTrace(traceFile);
+        cout << "Записано " << lastMetrics.additionalInfo["traceEvents"] << " подій у " << traceFile
+             << " (відкрийте у chrome://tracing або ui.perfetto.dev)" << endl;
+      }
+      catch (const exception &e)
+      {
+        cout << "Помилка: " << e.what() << endl;
+      }
+    }
+
+    // Зберігаємо результат для порівняння
+    sortResults.push_back(SortResult(name, lastMetrics, usedThreads(lastMetrics)));
+
+    // Пропонуємо зберегти результат
+    if (getYesNoInput("Бажаєте оновити оригінальний масив відсортованим?"))
+    {
+      array = arrayCopy;
+      arrayOrigin.clear();
+      if (getYesNoInput("Бажаєте зберегти відсортований масив у файл?"))
+      {
+        saveArrayToFile(array);
+      }
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  // З параметрами командного рядка програма працює без меню
+  if (argc > 1)
+  {
+    return BatchMode::run(argc, argv);
+  }
+
   vector<int> array;
   bool arrayLoaded = false;
+  map<string, string> arrayOrigin; // Seed і розподіл згенерованого масиву; порожнє для завантаженого з файлу
   SortMetrics lastMetrics;
   vector<SortResult> sortResults;
-  int lastUsedThreads = 1;
 
   bool continueProgram = true;
   while (continueProgram)
@@ -62,6 +159,7 @@ int main()
       switch (mainChoice)
       {
       case 0: // Вихід
+        ThreadPool::instance().shutdown();
         cout << "Програма завершена.\n";
         return 0;
 
@@ -77,7 +175,10 @@ int main()
           switch (arrayChoice)
           {
           case 1:
+          case 6:
           { // Генерація масиву
+            Distribution distribution = arrayChoice == 6 ? getDistributionMode() : Distribution::Uniform;
+
             int size = getIntInput("Введіть розмір масиву: ");
             int minValue = getIntInput("Введіть мінімальне значення: ");
             int maxValue = getIntInput("Введіть максимальне значення: ");
@@ -94,10 +195,19 @@ int main()
               swap(minValue, maxValue);
             }
 
-            array = ArrayOperations::generateRandomArray(size, minValue, maxValue);
+            DistributionParams params;
+            params.minValue = minValue;
+            params.maxValue = maxValue;
+            getDistributionParams(distribution, params);
+            uint64_t seed = getSeedInput();
+
+            array = ArrayOperations::generateArray(size, distribution, params, seed);
             arrayLoaded = true;
+            arrayOrigin.clear();
+            arrayOrigin["seed"] = to_string(seed);
+            arrayOrigin["distribution"] = ArrayGenerator::distributionName(distribution);
 
-            cout << "Масив успішно згенеровано.\n";
+            cout << "Масив успішно згенеровано (розподіл: " << arrayOrigin["distribution"] << ", seed: " << seed << ").\n";
             printArrayInfo(array);
 
             // Пропозиція зберегти масив
@@ -113,10 +223,13 @@ int main()
           case 2:
           { // Завантаження з файлу
             string filename = getStringInput("Введіть ім'я файлу для зчитування: ");
-            array = ArrayOperations::loadArrayFromFile(filename);
+            IoStats loadStats;
+            array = ArrayOperations::loadArrayFromFile(filename, &loadStats);
             arrayLoaded = true;
+            arrayOrigin.clear();
 
             cout << "Масив успішно зчитано з файлу " << filename << endl;
+            printIoStats(loadStats);
             printArrayInfo(array);
 
             if (array.size() <= 100 && getYesNoInput("Бажаєте переглянути завантажений масив?"))
@@ -186,7 +299,7 @@ int main()
             break;
           }
           default:
-            cout << "Помилка: невірний вибір. Виберіть опцію від 0 до 5.\n";
+            cout << "Помилка: невірний вибір. Виберіть опцію від 0 до 6.\n";
           }
         }
         break;
@@ -201,7 +314,7 @@ int main()
           if (sortChoice == 0)
             break;
 
-          if (!arrayLoaded && sortChoice >= 1 && sortChoice <= 3)
+          if (!arrayLoaded && ((sortChoice >= 1 && sortChoice <= 5) || sortChoice == 8 || sortChoice == 9))
           {
             cout << "Помилка: спочатку потрібно завантажити або згенерувати масив.\n";
             continue;
@@ -211,83 +324,92 @@ int main()
           {
           case 1:
           { // Послідовне сортування
-            // Зберігаємо копію масиву для можливості порівняння результатів
-            vector<int> arrayCopy = array;
-
             cout << "Початок сортування масиву розміром " << array.size() << " елементів...\n";
 
-            bool detailedMode = getDetailedMode();
+            Instrumentation instrumentation = getInstrumentationMode();
 
-            lastMetrics = ArrayOperations::bubbleSort(arrayCopy, detailedMode);
+            sortCopyAndReport(array, arrayOrigin, "Послідовний", [&](vector<int> &arrayCopy)
+                              { return ArrayOperations::bubbleSort(arrayCopy, instrumentation); },
+                              lastMetrics, sortResults);
+            break;
+          }
+          case 2:
+          { // Багатопотокове сортування
+            cout << "Початок багатопотокового сортування масиву розміром " << array.size() << " елементів...\n";
 
-            bool isSorted = ArrayOperations::isSorted(arrayCopy);
-            cout << "Масив " << (isSorted ? "успішно відсортований" : "НЕ відсортований") << ".\n";
+            int numThreads = getIntInput("Введіть кількість потоків (0 для автоматичного визначення): ");
 
-            if (isSorted)
-            {
-              ArrayOperations::printMetrics(lastMetrics);
+            SegmentKernel segmentKernel = getYesNoInput("Використовувати SIMD-ядро для сортування сегментів?")
+                                              ? SegmentKernel::Simd
+                                              : SegmentKernel::Bubble;
 
-              // Зберігаємо результат для порівняння
-              sortResults.push_back(SortResult("Послідовний", lastMetrics, 1));
+            Instrumentation instrumentation = getInstrumentationMode();
 
-              // Пропонуємо зберегти результат
-              if (getYesNoInput("Бажаєте оновити оригінальний масив відсортованим?"))
-              {
-                array = arrayCopy;
-                if (getYesNoInput("Бажаєте зберегти відсортований масив у файл?"))
-                {
-                  saveArrayToFile(array);
-                }
-              }
-            }
+            sortCopyAndReport(array, arrayOrigin, segmentKernel == SegmentKernel::Simd ? "Багатопотоковий SIMD" : "Багатопотоковий",
+                              [&](vector<int> &arrayCopy)
+                              { return ArrayOperations::bubbleSortMultithreaded(arrayCopy, numThreads, instrumentation, segmentKernel); },
+                              lastMetrics, sortResults);
             break;
           }
-          case 2:
-          { // Багатопотокове сортування
-            // Зберігаємо копію масиву для можливості порівняння результатів
-            vector<int> arrayCopy = array;
-
-            cout << "Початок багатопотокового сортування масиву розміром " << array.size() << " елементів...\n";
+          case 3:
+          { // Парно-непарне сортування
+            cout << "Початок парно-непарного сортування масиву розміром " << array.size() << " елементів...\n";
 
             int numThreads = getIntInput("Введіть кількість потоків (0 для автоматичного визначення): ");
 
             bool detailedMode = getDetailedMode();
 
-            lastMetrics = ArrayOperations::bubbleSortMultithreaded(arrayCopy, numThreads, detailedMode);
-            lastUsedThreads = stoi(lastMetrics.additionalInfo["numThreads"]);
+            sortCopyAndReport(array, arrayOrigin, "Парно-непарний", [&](vector<int> &arrayCopy)
+                              { return ArrayOperations::oddEvenSortMultithreaded(arrayCopy, numThreads, detailedMode); },
+                              lastMetrics, sortResults);
+            break;
+          }
+          case 4:
+          { // Адаптивні варіанти бульбашки
+            cout << "Виберіть варіант:\n";
+            cout << "1. Бульбашка з ранньою зупинкою\n";
+            cout << "2. Шейкерне сортування (cocktail shaker)\n";
+            cout << "3. Сортування гребінцем (comb sort)\n";
+            int variantChoice = getIntInput("Ваш вибір: ");
+
+            if (variantChoice < 1 || variantChoice > 3)
+            {
+              cout << "Помилка: невірний вибір варіанту.\n";
+              break;
+            }
 
-            bool isSorted = ArrayOperations::isSorted(arrayCopy);
-            cout << "Масив " << (isSorted ? "успішно відсортований" : "НЕ відсортований") << ".\n";
+            const BubbleVariant variants[] = {BubbleVariant::EarlyExit, BubbleVariant::CocktailShaker, BubbleVariant::Comb};
+            const string names[] = {"Рання зупинка", "Шейкерний", "Гребінцевий"};
+            BubbleVariant variant = variants[variantChoice - 1];
 
-            if (isSorted)
-            {
-              ArrayOperations::printMetrics(lastMetrics);
+            cout << "Початок адаптивного сортування масиву розміром " << array.size() << " елементів...\n";
 
-              // Зберігаємо результат для порівняння
-              sortResults.push_back(SortResult("Багатопотоковий", lastMetrics, lastUsedThreads));
+            Instrumentation instrumentation = getInstrumentationMode();
 
-              // Пропонуємо зберегти результат
-              if (getYesNoInput("Бажаєте оновити оригінальний масив відсортованим?"))
-              {
-                array = arrayCopy;
-                if (getYesNoInput("Бажаєте зберегти відсортований масив у файл?"))
-                {
-                  saveArrayToFile(array);
-                }
-              }
-            }
+            sortCopyAndReport(array, arrayOrigin, names[variantChoice - 1], [&](vector<int> &arrayCopy)
+                              { return ArrayOperations::adaptiveBubbleSort(arrayCopy, variant, instrumentation); },
+                              lastMetrics, sortResults);
             break;
           }
-          case 3:
+          case 5:
           { // Перевірка сортування
-            bool isSorted = ArrayOperations::isSorted(array);
-            cout << "Результат перевірки: масив " << (isSorted ? "відсортований" : "НЕ відсортований") << endl;
+            ArrayStatistics<int> stats = ArrayOperations::scanArray(array);
+            if (stats.sorted)
+            {
+              cout << "Результат перевірки: масив відсортований" << endl;
+            }
+            else
+            {
+              cout << "Результат перевірки: масив НЕ відсортований, перше порушення порядку на індексі "
+                   << stats.firstUnsortedIndex << " (неспадних серій: " << stats.runCount << ")" << endl;
+            }
 
-            if (!isSorted && getYesNoInput("Бажаєте відсортувати масив?"))
+            if (!stats.sorted && getYesNoInput("Бажаєте відсортувати масив?"))
             {
               cout << "Виберіть метод сортування:\n";
               cout << "1. Звичайне сортування\n";
               cout << "2. Багатопотокове сортування\n";
+              cout << "3. Парно-непарне сортування\n";
               int choice = getIntInput("Ваш вибір: ");
 
               bool detailedMode = getDetailedMode();
@@ -295,16 +417,25 @@ int main()
               if (choice == 1)
               {
                 lastMetrics = ArrayOperations::bubbleSort(array, detailedMode);
+                recordArrayOrigin(lastMetrics, arrayOrigin);
                 sortResults.push_back(SortResult("Послідовний", lastMetrics, 1));
               }
+              else if (choice == 3)
+              {
+                int numThreads = getIntInput("Введіть кількість потоків (0 для автоматичного визначення): ");
+                lastMetrics = ArrayOperations::oddEvenSortMultithreaded(array, numThreads, detailedMode);
+                recordArrayOrigin(lastMetrics, arrayOrigin);
+                sortResults.push_back(SortResult("Парно-непарний", lastMetrics, usedThreads(lastMetrics)));
+              }
               else
               {
                 int numThreads = getIntInput("Введіть кількість потоків (0 для автоматичного визначення): ");
                 lastMetrics = ArrayOperations::bubbleSortMultithreaded(array, numThreads, detailedMode);
-                lastUsedThreads = stoi(lastMetrics.additionalInfo["numThreads"]);
-                sortResults.push_back(SortResult("Багатопотоковий", lastMetrics, lastUsedThreads));
+                recordArrayOrigin(lastMetrics, arrayOrigin);
+                sortResults.push_back(SortResult("Багатопотоковий", lastMetrics, usedThreads(lastMetrics)));
               }
 
+              arrayOrigin.clear();
               cout << "Масив успішно відсортовано.\n";
               ArrayOperations::printMetrics(lastMetrics);
 
@@ -315,7 +446,7 @@ int main()
             }
             break;
           }
-          case 4:
+          case 6:
           { // Показ метрик
             if (sortResults.empty())
             {
@@ -351,8 +482,51 @@ int main()
             }
             break;
           }
+          case 7:
+          { // Зовнішнє сортування
+            string inputFile = getStringInput("Введіть ім'я вхідного файлу: ");
+            string outputFile = getStringInput("Введіть ім'я вихідного файлу: ");
+            int budgetMb = getIntInput("Введіть бюджет пам'яті в МБ: ");
+            int numThreads = getIntInput("Введіть кількість потоків (0 для автоматичного визначення): ");
+            ArrayFileFormat format = getYesNoInput("Зберегти результат у бінарному форматі?")
+                                         ? ArrayFileFormat::Binary
+                                         : ArrayFileFormat::Text;
+
+            lastMetrics = ExternalSort::sortFile(inputFile, outputFile, static_cast<size_t>(max(budgetMb, 0)) << 20, numThreads, format);
+            cout << "Файл " << inputFile << " відсортовано у " << outputFile << ".\n";
+            ArrayOperations::printMetrics(lastMetrics);
+            sortResults.push_back(SortResult("Зовнішній", lastMetrics, usedThreads(lastMetrics)));
+            break;
+          }
+          case 8:
+          { // Порозрядне сортування
+            cout << "Початок порозрядного сортування масиву розміром " << array.size() << " елементів...\n";
+
+            int numThreads = getIntInput("Введіть кількість потоків (0 для автоматичного визначення): ");
+
+            Instrumentation instrumentation = getInstrumentationMode();
+
+            sortCopyAndReport(array, arrayOrigin, "Порозрядний", [&](vector<int> &arrayCopy)
+                              { return ArrayOperations::radixSort(arrayCopy, numThreads, instrumentation); },
+                              lastMetrics, sortResults);
+            break;
+          }
+          case 9:
+          { // Автоматичний вибір
+            cout << "Аналіз масиву розміром " << array.size() << " елементів для вибору методу сортування...\n";
+
+            SortOptions options;
+            options.numThreads = getIntInput("Введіть максимальну кількість потоків (0 - усі ядра): ");
+
+            options.instrumentation = getInstrumentationMode();
+
+            sortCopyAndReport(array, arrayOrigin, "Автоматичний", [&](vector<int> &arrayCopy)
+                              { return SortPlanner::autoSort(arrayCopy, options); },
+                              lastMetrics, sortResults);
+            break;
+          }
           default:
-            cout << "Помилка: невірний вибір. Виберіть опцію від 0 до 4.\n";
+            cout << "Помилка: невірний вибір. Виберіть опцію від 0 до 9.\n";
           }
         }
         break;